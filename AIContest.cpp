@@ -23,42 +23,105 @@
 using namespace std;
 using namespace conio;
 
+const char* const AIContest::shipNames[MAX_SHIPS] = {
+    "Submarine", "Destroyer", "Aircraft Carrier", "Destroyer 2", "Submarine 2", "Aircraft Carrier 2"
+};
+
 AIContest::AIContest( PlayerV2* player1, string player1Name, 
                       PlayerV2* player2, string player2Name,
 		      int boardSize, bool silent )
 {
-    // Set up player 1
-    this->player1 = player1;
-    this->player1Board = new BoardV3(boardSize);
-    this->player1Name = player1Name;
-    this->player1Won = false;
+    init( boardSize, silent, 0 );
+    setPlayers( player1, player1Name, player2, player2Name );
+    this->haveGameId = false;
 
-    // Set up player 2
-    this->player2 = player2;
-    this->player2Board = new BoardV3(boardSize);
-    this->player2Name = player2Name;
+    for(int i=0; i<numShips; i++) {
+	shipLengths[i] = random()%(MIN_SHIP_SIZE) + 3;
+    }
+}
+
+/**
+ * Sets up one game of a tournament: ship lengths come from the game's
+ * controller stream, and packed players get their own streams of it.
+ * Boards come from makeBoard, or are BoardV3s if it is null.
+ */
+AIContest::AIContest( PlayerV2* player1, string player1Name, 
+                      PlayerV2* player2, string player2Name,
+		      int boardSize, bool silent, const GameId& game, BoardFactory makeBoard )
+{
+    init( boardSize, silent, makeBoard );
+    setPlayers( player1, player1Name, player2, player2Name );
+    reset( game );
+}
+
+AIContest::AIContest( int boardSize, BoardFactory makeBoard ) {
+    init( boardSize, true, makeBoard );
+    setPlayers( 0, "", 0, "" );
+    this->haveGameId = false;
+}
+
+void AIContest::init( int boardSize, bool silent, BoardFactory makeBoard ) {
+    if( !makeBoard ) makeBoard = &BoardV3::create;
+    this->player1Board = makeBoard(boardSize);
+    this->player2Board = makeBoard(boardSize);
+    this->player1Won = false;
     this->player2Won = false;
 
     // General
     this->boardSize = boardSize;
     this->silent = silent;
+    this->report = &cout;
+    this->log = 0;
+    this->player1Timing = 0;
+    this->player2Timing = 0;
 
-    // Ship stuff
-    shipNames[0] = "Submarine";
-    shipNames[1] = "Destroyer";
-    shipNames[2] = "Aircraft Carrier";
-    shipNames[3] = "Destroyer 2";
-    shipNames[4] = "Submarine 2";
-    shipNames[5] = "Aircraft Carrier 2";
-    
+    // Larger boards get a larger fleet: boardSize-2 ships, so players that
+    // put one ship per row still fit.
     numShips = boardSize-2;
-    if( numShips > MAX_SHIPS ) {
+    if( numShips > MAX_SHIPS && boardSize <= MAX_BOARD_SIZE ) {
     	numShips = MAX_SHIPS;
     }
+    shipLengths.resize(numShips);
+}
 
+/**
+ * Seats the players for the following games. Works out once here whether
+ * they speak the packed protocol.
+ */
+void AIContest::setPlayers( PlayerV2* player1, const string& player1Name,
+                            PlayerV2* player2, const string& player2Name )
+{
+    this->player1 = player1;
+    this->packedPlayer1 = dynamic_cast<PackedPlayerV2*>(player1);
+    this->player1Name = player1Name;
+    this->player2 = player2;
+    this->packedPlayer2 = dynamic_cast<PackedPlayerV2*>(player2);
+    this->player2Name = player2Name;
+}
+
+/**
+ * Gets ready to play game (seed, pairing, round): empties both boards in
+ * place, rolls the fleet from the game's controller stream and hands packed
+ * players their streams. Allocates nothing.
+ */
+void AIContest::reset( const GameId& game ) {
+    this->gameId = game;
+    this->haveGameId = true;
+    player1Board->clear();
+    player2Board->clear();
+    player1Won = false;
+    player2Won = false;
+
+    Random controller = Random::forGame(game, Random::Controller);
     for(int i=0; i<numShips; i++) {
-	shipLengths[i] = random()%(MIN_SHIP_SIZE) + 3;
+	shipLengths[i] = controller.below(MIN_SHIP_SIZE) + 3;
     }
+    if( packedPlayer1 ) packedPlayer1->setRandom(Random::forGame(game, Random::Player1));
+    if( packedPlayer2 ) packedPlayer2->setRandom(Random::forGame(game, Random::Player2));
+}
+
+void AIContest::setSilent( bool silent ) {
+    this->silent = silent;
 }
 
 AIContest::~AIContest() {
@@ -66,16 +129,111 @@ AIContest::~AIContest() {
     delete this->player2Board;
 }
 
+/**
+ * Sets where the result lines of play() are written. Defaults to cout;
+ * pass null to play without any output, e.g. from worker threads.
+ */
+void AIContest::setReport( ostream* report ) {
+    this->report = report;
+}
+
+/**
+ * Records the game (fleet, placements, shots) in log when it ends; pass
+ * null, the default, to record nothing.
+ */
+void AIContest::setLog( GameLogWriter* log ) {
+    this->log = log;
+}
+
+/**
+ * Plays with the given fleet (numShips lengths, boardSize-2; up to 6 on
+ * boards up to MAX_BOARD_SIZE)
+ * instead of the random one, e.g. to play a logged game again.
+ */
+void AIContest::setShipLengths( const int lengths[] ) {
+    for(int i=0; i<numShips; i++) {
+	shipLengths[i] = lengths[i];
+    }
+}
+
+/**
+ * Times every call into the players, into the given histograms (see
+ * PlayerTiming.h). Null, the default, doesn't time them.
+ */
+void AIContest::setTiming( PlayerTiming* player1Timing, PlayerTiming* player2Timing ) {
+    this->player1Timing = player1Timing;
+    this->player2Timing = player2Timing;
+}
+
+PackedPlayerV2* AIContest::packedFor( PlayerV2 *player ) {
+    return player == player1 ? packedPlayer1 : packedPlayer2;
+}
+
+PlayerTiming* AIContest::timingFor( PlayerV2 *player ) {
+    return player == player1 ? player1Timing : player2Timing;
+}
+
+/**
+ * Asks a player for its next shot.
+ */
+PackedMessage AIContest::getMove( PlayerV2 *player ) {
+    CallTimer timer( timingFor(player), GetMoveCall );
+    PackedPlayerV2* packed = packedFor(player);
+    if( packed ) {
+	return packed->getPackedMove();
+    }
+    Message move = player->getMove();
+    return PackedMessage::pack(move);
+}
+
+/**
+ * Asks a player where to put a ship.
+ */
+PackedMessage AIContest::placeShip( PlayerV2 *player, int length ) {
+    CallTimer timer( timingFor(player), PlaceShipCall );
+    PackedPlayerV2* packed = packedFor(player);
+    if( packed ) {
+	return packed->placePackedShip(length);
+    }
+    Message loc = player->placeShip(length);
+    return PackedMessage::pack(loc);
+}
+
+/**
+ * Tells a player what happened. Players on the old protocol get a Message.
+ */
+void AIContest::notify( PlayerV2 *player, PackedMessage msg ) {
+    CallTimer timer( timingFor(player), UpdateCall );
+    PackedPlayerV2* packed = packedFor(player);
+    if( packed ) {
+	packed->updatePacked(msg);
+    } else {
+	player->update(msg.unpack());
+    }
+}
+
+/**
+ * True if the player has given up the game (a sandboxed player that was
+ * too slow or crashed); says so in the report.
+ */
+bool AIContest::forfeits( PlayerV2 *player, const string& playerName ) {
+    PackedPlayerV2* packed = packedFor(player);
+    if( !packed || !packed->forfeited() ) return false;
+    if( report ) *report << playerName << " can't go on and forfeits the game." << endl;
+    return true;
+}
+
 /**
  * Places the ships. 
  */
 //bool AIContest::placeShips( PlayerV2* player, BoardV3* board, BoardV3* testingBoard ) {
-bool AIContest::placeShips( PlayerV2* player, BoardV3* board ) {
+bool AIContest::placeShips( PlayerV2* player, GameBoard* board ) {
     for( int i=0; i<numShips; i++ ) {
-	Message loc = player->placeShip( shipLengths[i] );
+	PackedMessage loc = placeShip( player, shipLengths[i] );
+	if( log ) record.addPlacement( player == player1 ? 0 : 1, loc.getRow(), loc.getCol(), loc.getDirection() );
 	bool placedOk = board->placeShip( loc.getRow(), loc.getCol(), shipLengths[i], loc.getDirection() );
 	if( ! placedOk ) {
-	    cerr << "Error: couldn't place "<<shipNames[i]<<" (length "<<shipLengths[i]<<")"<<endl;
+	    cerr << "Error: couldn't place "<<shipName(i)<<" (length "<<shipLengths[i]<<")"<<endl;
 	    return false;
 	}
     }
@@ -84,7 +242,11 @@ bool AIContest::placeShips( PlayerV2* player, BoardV3* board ) {
     return true;
 }
 
-void AIContest::showBoard(BoardV3* board, bool ownerView, string playerName,
+string AIContest::shipName( int ship ) {
+    return ship < MAX_SHIPS ? shipNames[ship] : "Ship " + to_string(ship+1);
+}
+
+void AIContest::showBoard(GameBoard* board, bool ownerView, string playerName,
 			  bool fullRedraw, Side side, bool hLMostRecentShot, int hLRow, int hLCol ) {
     if( silent ) return;
     // 'fullRedraw' indicates full board draw or only an update.
@@ -105,7 +267,7 @@ void AIContest::showBoard(BoardV3* board, bool ownerView, string playerName,
     // Top row
     cout << gotoRowCol(3, boardColOffset) << " |";
     for(int count=0; count<boardSize; count++) {
-	cout << count;
+	cout << count % 10;
     }
     cout << flush;
 
@@ -158,22 +320,30 @@ void AIContest::snooze( float seconds ) {
     usleep(sleepTime);
 }
 
-void AIContest::updateAI(PlayerV2 *player, BoardV3 *board, int hitRow, int hitCol) {
-    Message killMsg( KILL, -1, -1, "");
-    char shipMark = board->getShipMark(hitRow, hitCol);
+/**
+ * Tells a player that its shot at hitRow/hitCol sank a ship. Packed players
+ * get one ShipKill; the rest get a HIT and then a KILL for every ship cell.
+ */
+void AIContest::updateAI(PlayerV2 *player, GameBoard *board, int hitRow, int hitCol) {
+    ShipKill kill = { hitRow, hitCol, boardSize, board->getShipCells(hitRow, hitCol),
+                      board->getShip(hitRow, hitCol) };
+    CallTimer timer( timingFor(player), UpdateCall );	// The whole kill counts as one update
+    PackedPlayerV2* packed = packedFor(player);
+    if( packed ) {
+	packed->updateKill(kill);
+	return;
+    }
 
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    if(board->getShipMark(row,col) == shipMark) {
-	        killMsg.setRow(row);
-	        killMsg.setCol(col);
-		player->update(killMsg);
-	    }
-	}
+    player->update(PackedMessage( HIT, hitRow, hitCol ).unpack());
+    PackedMessage killMsg( KILL );
+    for( int i=0; i<kill.length(); i++ ) {
+	killMsg.setRow(kill.cellRow(i));
+	killMsg.setCol(kill.cellCol(i));
+	player->update(killMsg.unpack());
     }
 }
 
-bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board, 
+bool AIContest::processShot(const string& playerName, PlayerV2 *player, GameBoard *board, 
                            Side side, int row, int col, PlayerV2 *otherPlayer) 
 {
     bool won = false;
@@ -183,10 +353,8 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
     // Wipe any previous contents clean first
     if( !silent ) cout << gotoRowCol( resultsRow, shotColOffset) << playerName 
                        << "'s shot: [" <<row<< "," <<col<< "]" << endl;
-    Message msg = board->processShot( row, col );
-    // Hack because board doesn't set these properly.
-    msg.setRow(row);
-    msg.setCol(col);
+    PackedMessage msg( board->processShot( row, col ), row, col );
+    if( log ) record.addShot( row, col, msg.getMessageType() );
 
     switch( msg.getMessageType() ) {
 	case MISS:
@@ -194,22 +362,17 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
 	    //if( !silent ) cout << gotoRowCol( resultsRow+1, boardColOffset ) << setw(30) << "";
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "Miss" << flush;
-	    player->update(msg);
+	    notify(player, msg);
 	    break;
 	case HIT:
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "Hit" << flush;
-	    player->update(msg);
+	    notify(player, msg);
 	    break;
 	case KILL:
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << setw(30) << "";
 	    if( !silent ) cout << gotoRowCol( resultsRow+1, shotColOffset ) << "It's a KILL! " << msg.getString() << flush;
-	    // Notify that is a hit
-	    msg.setMessageType(HIT);
-	    player->update(msg);
-	    // Probably not needed, but just to be safe ...
-	    msg.setMessageType(KILL);
-	    // and notify that all segments of ship are now a KILL
+	    // Notify that is a hit and that all segments of the ship are now a KILL
 	    updateAI(player, board, row, col);
 
 	    // Chance to win after every kill. Check
@@ -222,7 +385,7 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
 	        cout << gotoRowCol( resultsRow+1, boardColOffset ) << "You already shot there.";
 		cout << resetAll() << flush;
 	    }
-	    player->update(msg);
+	    notify(player, msg);
 	    break;
 	case INVALID_SHOT:
 	    if( !silent ) {
@@ -232,7 +395,7 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
 	             ", col="<<col<<"]" << flush;
 		cout << resetAll() << flush;
 	    }
-	    player->update(msg);
+	    notify(player, msg);
 	    break;
 	default:
 	    if( !silent ) {
@@ -242,13 +405,13 @@ bool AIContest::processShot(string playerName, PlayerV2 *player, BoardV3 *board,
 	                       << msg.getMessageType() << "(" << msg.getString() << ")";
 		cout << resetAll() << flush;
 	    }
-	    player->update(msg);
+	    notify(player, msg);
 	    break;
     }
 
     // Notify the other player of the shot
     msg.setMessageType(OPPONENT_SHOT);
-    otherPlayer->update(msg);
+    notify(otherPlayer, msg);
 
     return won;
 }
@@ -257,29 +420,34 @@ void AIContest::play( float secondsDelay, int& totalMoves, bool& player1Won, boo
     int maxShots = boardSize*boardSize*2;
     totalMoves = 0;
     clearScreen();
+    if( log ) {
+	record.begin( boardSize, numShips, &shipLengths[0] );
+	record.haveGameId = haveGameId;
+	if( haveGameId ) record.game = gameId;
+    }
 
     //showBoard(playerBoard, true, "Sneak peek at player's board");
     //BoardV3 testingBoard1(boardSize);
     //if( ! placeShips(player1, player1Board, testingBoard1) ) {
     if( ! placeShips(player1, player1Board) ) {
-	//if( ! silent ) {
-	    cout << endl;
-	    cout << player1Name << " placed ship in invalid location and forfeits game." << endl;
-	    cout << endl;
-	    snooze( secondsDelay*4 );
-	//}
+	if( report ) {
+	    *report << endl;
+	    *report << player1Name << " placed ship in invalid location and forfeits game." << endl;
+	    *report << endl;
+	}
+	snooze( secondsDelay*4 );
 	player2Won = true;
     }
 
     //BoardV3 testingBoard2(boardSize);
     //if( ! placeShips(player2, player2Board, testingBoard2) ) {
     if( ! placeShips(player2, player2Board) ) {
-	//if( ! silent ) {
-	    cout << endl;
-	    cout << player2Name << " placed ship in invalid location and forfeits game." << endl;
-	    cout << endl;
-	    snooze( secondsDelay*4 );
-	//}
+	if( report ) {
+	    *report << endl;
+	    *report << player2Name << " placed ship in invalid location and forfeits game." << endl;
+	    *report << endl;
+	}
+	snooze( secondsDelay*4 );
 	player1Won = true;
     }
 
@@ -287,9 +455,17 @@ void AIContest::play( float secondsDelay, int& totalMoves, bool& player1Won, boo
     while ( !(player1Won || player2Won) && totalMoves < maxShots ){
 	//clearScreen();
 
-	Message shot1 = player1->getMove();
+	PackedMessage shot1 = getMove(player1);
+	if( forfeits(player1, player1Name) ) {
+	    player2Won = true;
+	    break;
+	}
 	player1Won = processShot(player1Name, player1, player2Board, Left, shot1.getRow(), shot1.getCol(), player2);
-	Message shot2 = player2->getMove();
+	PackedMessage shot2 = getMove(player2);
+	if( forfeits(player2, player2Name) ) {
+	    player1Won = true;
+	    break;
+	}
 	player2Won = processShot(player2Name, player2, player1Board, Right, shot2.getRow(), shot2.getCol(), player1);
 
 	if( ! silent ) {
@@ -319,32 +495,43 @@ void AIContest::play( float secondsDelay, int& totalMoves, bool& player1Won, boo
 	cout << endl;
     }
 
+    if( log ) {
+	record.playerNames[0] = player1Name;
+	record.playerNames[1] = player2Name;
+	record.playerWon[0] = player1Won;
+	record.playerWon[1] = player2Won;
+	record.totalMoves = totalMoves;
+	log->write( record );
+    }
+
     if( player1Won && player2Won ) {
-	cout << "The game was a tie. Both players sunk all ships." << endl;
-	Message msg(TIE);
-	player1->update(msg);
-	player2->update(msg);
+	if( report ) *report << "The game was a tie. Both players sunk all ships." << endl;
+	PackedMessage msg(TIE);
+	notify(player1, msg);
+	notify(player2, msg);
     } else if( player1Won ) {
-	cout << player1Name << " won." << endl;
-	Message msg(WIN);
-	player1->update(msg);
+	if( report ) *report << player1Name << " won." << endl;
+	PackedMessage msg(WIN);
+	notify(player1, msg);
 	msg.setMessageType(LOSE);
-	player2->update(msg);
+	notify(player2, msg);
     } else if( player2Won ) {
-	cout << player2Name << " won." << endl;
-	Message msg(WIN);
-	player2->update(msg);
+	if( report ) *report << player2Name << " won." << endl;
+	PackedMessage msg(WIN);
+	notify(player2, msg);
 	msg.setMessageType(LOSE);
-	player1->update(msg);
+	notify(player1, msg);
     } else {   // both timed out -- neither won
-	cout << "The game was a tie. Neither player sunk all ships." << endl;
-	Message msg(LOSE);
-	player1->update(msg);
-	player2->update(msg);
+	if( report ) *report << "The game was a tie. Neither player sunk all ships." << endl;
+	PackedMessage msg(LOSE);
+	notify(player1, msg);
+	notify(player2, msg);
     }
-    cout << "--- (Moves = " << totalMoves << ", percentage of board shot at = " <<
+    if( report ) *report << "--- (Moves = " << totalMoves << ", percentage of board shot at = " <<
 			    (100.0*(float)totalMoves)/(boardSize*boardSize) << "%.)" << endl;
-    cout << endl;
+    if( report && haveGameId ) *report << "--- Game " << gameId.pairing << ":" << gameId.round
+				       << " (seed " << gameId.seed << ")" << endl;
+    if( report ) *report << endl;
     if( ! silent ) {
 	snooze( 5 );
     }
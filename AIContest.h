@@ -11,9 +11,16 @@
 #define AICONTEST_H
 
 // BattleShips project specific includes.
+#include <vector>
+
 #include "Message.h"
 #include "BoardV3.h"
+#include "GameBoard.h"
 #include "PlayerV2.h"
+#include "PackedPlayerV2.h"
+#include "Random.h"
+#include "GameLog.h"
+#include "PlayerTiming.h"
 
 using namespace std;
 
@@ -22,37 +29,71 @@ class AIContest {
     AIContest( PlayerV2* player1, string player1Name,
                PlayerV2* player2, string player2Name,
 	       int boardSize, bool silent );
+    AIContest( PlayerV2* player1, string player1Name,
+               PlayerV2* player2, string player2Name,
+	       int boardSize, bool silent, const GameId& game, BoardFactory makeBoard = 0 );
+    /**
+     * @brief A reusable contest: give it players with setPlayers() and a
+     * game with reset() before each play().
+     */
+    AIContest( int boardSize, BoardFactory makeBoard = 0 );
     ~AIContest();
+    void setPlayers( PlayerV2* player1, const string& player1Name,
+                     PlayerV2* player2, const string& player2Name );
+    void reset( const GameId& game );
+    void setSilent( bool silent );
     void play( float secondsDelay, int& totalMoves, bool& player1Won, bool& player2Won );
+    void setReport( ostream* report );
+    void setLog( GameLogWriter* log );
+    void setShipLengths( const int lengths[] );
+    void setTiming( PlayerTiming* player1Timing, PlayerTiming* player2Timing );
 
   private:
     enum Side { Left=1, Right=2 };
+    void init( int boardSize, bool silent, BoardFactory makeBoard );
     //bool placeShips( PlayerV2* player, BoardV3* board, BoardV3* testingBoard );
-    bool placeShips( PlayerV2* player, BoardV3* board);
-    void showBoard(BoardV3* board, bool ownerView, string playerName,
+    bool placeShips( PlayerV2* player, GameBoard* board);
+    void showBoard(GameBoard* board, bool ownerView, string playerName,
                    bool fullRedraw, Side side, bool hLMostRecentShot, int hLRow, int hLCol );
     void clearScreen();
-    void updateAI(PlayerV2 *player, BoardV3 *board, int hitRow, int hitCol);
+    void updateAI(PlayerV2 *player, GameBoard *board, int hitRow, int hitCol);
     void snooze(float seconds);
-    bool processShot(string playerName, PlayerV2 *player, BoardV3 *board, Side side, int row, int col, PlayerV2* otherPlayer);
+    bool processShot(const string& playerName, PlayerV2 *player, GameBoard *board, Side side, int row, int col, PlayerV2* otherPlayer);
+    // Player calls, using the packed protocol when the player speaks it
+    PackedMessage getMove(PlayerV2 *player);
+    PackedMessage placeShip(PlayerV2 *player, int length);
+    void notify(PlayerV2 *player, PackedMessage msg);
+    PackedPlayerV2* packedFor(PlayerV2 *player);
+    PlayerTiming* timingFor(PlayerV2 *player);
+    bool forfeits(PlayerV2 *player, const string& playerName);
+    string shipName(int ship);
 
     // Data
     PlayerV2 *player1;
     PlayerV2 *player2;
-    BoardV3 *player1Board;
+    PackedPlayerV2 *packedPlayer1;	// player1 if it speaks the packed protocol, else null
+    PackedPlayerV2 *packedPlayer2;
+    GameBoard *player1Board;
     //BoardV3 *player1testingBoard;
-    BoardV3 *player2Board;
+    GameBoard *player2Board;
     //BoardV3 *player2testingBoard;
     string player1Name;
     string player2Name;
     int boardSize;
     bool silent;
+    ostream* report;	// Where game results go; null for none
+    GameId gameId;	// Which game this is, if haveGameId
+    bool haveGameId;
+    GameLogWriter* log;	// Where the game is recorded; null for nowhere
+    GameRecord record;
+    PlayerTiming* player1Timing;	// Where the players' call times go; null for nowhere
+    PlayerTiming* player2Timing;
     bool player1Won;
     bool player2Won;
     int NumShips;
-    static const int MAX_SHIPS = 6;
-    string shipNames[MAX_SHIPS];
-    int shipLengths[MAX_SHIPS];
+    static const int MAX_SHIPS = 6;	// Fleet limit on boards up to MAX_BOARD_SIZE
+    static const char* const shipNames[MAX_SHIPS];	// Ships after these are "Ship 7", "Ship 8", ...
+    vector<int> shipLengths;
     int numShips;
 };
 
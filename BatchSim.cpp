@@ -0,0 +1,365 @@
+/**
+ * BatchSim.cpp: plays many games between two ScanPlayers at once.
+ * Date:         October 2026
+ */
+
+#include <cstring>
+
+#include "BatchSim.h"
+#include "Random.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BATCHSIM_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    /*
+     * The lanes of the board being shot at, and where the shooter's wins go.
+     * count is a multiple of 4.
+     */
+    struct Target {
+	uint64_t* left[2];
+	uint64_t* ships[BatchSim::MaxShips][2];
+	int numShips;
+	const uint64_t* active;
+	uint64_t* won;
+	int count;
+    };
+
+    /*
+     * Fires at bit of word in every active lane of target. Returns the hits
+     * and kills in tally.
+     */
+    typedef void (*ShootFunction)( const Target& target, int word, uint64_t bit, ScanTally& tally );
+
+    /*
+     * Ends the lanes somebody won at move step: clears active and sets
+     * moves. Returns how many lanes are still playing.
+     */
+    typedef int (*RetireFunction)( uint64_t* active, const uint64_t* won0, const uint64_t* won1,
+				   int64_t* moves, int step, int count );
+
+    void shootPlain( const Target& target, int word, uint64_t bit, ScanTally& tally ) {
+	for( int i=0; i<target.count; i++ ) {
+	    uint64_t mask = bit & target.active[i];
+	    if( !(target.left[word][i] & mask) ) continue;
+	    target.left[word][i] &= ~mask;
+	    tally.hits++;
+	    for( int ship=0; ship<target.numShips; ship++ ) {
+		uint64_t* cells = target.ships[ship][word];
+		if( !(cells[i] & mask) ) continue;
+		cells[i] &= ~mask;
+		if( !(target.ships[ship][0][i] | target.ships[ship][1][i]) ) tally.kills++;
+		break;
+	    }
+	    if( !(target.left[0][i] | target.left[1][i]) ) target.won[i] = ~uint64_t(0);
+	}
+    }
+
+    int retirePlain( uint64_t* active, const uint64_t* won0, const uint64_t* won1,
+		     int64_t* moves, int step, int count )
+    {
+	int playing = 0;
+	for( int i=0; i<count; i++ ) {
+	    if( active[i] && (won0[i] | won1[i]) ) {
+		active[i] = 0;
+		moves[i] = step+1;
+	    }
+	    if( active[i] ) playing++;
+	}
+	return playing;
+    }
+
+#ifdef BATCHSIM_X86
+    // SSE2 has no 64-bit compare: a lane is zero when both its halves are.
+    inline __m128i isZero64( __m128i x ) {
+	__m128i halves = _mm_cmpeq_epi32(x, _mm_setzero_si128());
+	return _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xb1));
+    }
+
+    inline int laneCount2( __m128i mask ) {
+	return __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+    }
+
+    void shootSse2( const Target& target, int word, uint64_t bit, ScanTally& tally ) {
+	const __m128i ones = _mm_set1_epi32(-1);
+	const __m128i shot = _mm_set1_epi64x(bit);
+	for( int i=0; i<target.count; i+=2 ) {
+	    __m128i mask = _mm_and_si128(shot, _mm_loadu_si128((const __m128i*)(target.active+i)));
+	    __m128i left = _mm_loadu_si128((const __m128i*)(target.left[word]+i));
+	    __m128i hit = _mm_xor_si128(isZero64(_mm_and_si128(left, mask)), ones);
+	    int hits = laneCount2(hit);
+	    if( hits == 0 ) continue;
+	    tally.hits += hits;
+
+	    left = _mm_andnot_si128(mask, left);
+	    _mm_storeu_si128((__m128i*)(target.left[word]+i), left);
+	    __m128i rest = _mm_loadu_si128((const __m128i*)(target.left[1-word]+i));
+	    __m128i won = _mm_and_si128(hit, isZero64(_mm_or_si128(left, rest)));
+	    __m128i* wonAt = (__m128i*)(target.won+i);
+	    _mm_storeu_si128(wonAt, _mm_or_si128(_mm_loadu_si128(wonAt), won));
+
+	    for( int ship=0; ship<target.numShips; ship++ ) {
+		__m128i* cellsAt = (__m128i*)(target.ships[ship][word]+i);
+		__m128i cells = _mm_loadu_si128(cellsAt);
+		__m128i inShip = _mm_xor_si128(isZero64(_mm_and_si128(cells, mask)), ones);
+		if( laneCount2(inShip) == 0 ) continue;
+		cells = _mm_andnot_si128(mask, cells);
+		_mm_storeu_si128(cellsAt, cells);
+		__m128i other = _mm_loadu_si128((const __m128i*)(target.ships[ship][1-word]+i));
+		tally.kills += laneCount2(_mm_and_si128(inShip, isZero64(_mm_or_si128(cells, other))));
+	    }
+	}
+    }
+
+    int retireSse2( uint64_t* active, const uint64_t* won0, const uint64_t* won1,
+		    int64_t* moves, int step, int count )
+    {
+	const __m128i moveCount = _mm_set1_epi64x(step+1);
+	int playing = 0;
+	for( int i=0; i<count; i+=2 ) {
+	    __m128i was = _mm_loadu_si128((const __m128i*)(active+i));
+	    __m128i over = _mm_or_si128(_mm_loadu_si128((const __m128i*)(won0+i)),
+					_mm_loadu_si128((const __m128i*)(won1+i)));
+	    __m128i ended = _mm_and_si128(was, over);
+	    __m128i now = _mm_andnot_si128(over, was);
+	    _mm_storeu_si128((__m128i*)(active+i), now);
+	    __m128i* movesAt = (__m128i*)(moves+i);
+	    __m128i kept = _mm_andnot_si128(ended, _mm_loadu_si128(movesAt));
+	    _mm_storeu_si128(movesAt, _mm_or_si128(kept, _mm_and_si128(ended, moveCount)));
+	    playing += laneCount2(now);
+	}
+	return playing;
+    }
+
+    __attribute__((target("avx2"))) inline int laneCount4( __m256i mask ) {
+	return __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    }
+
+    __attribute__((target("avx2")))
+    void shootAvx2( const Target& target, int word, uint64_t bit, ScanTally& tally ) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ones = _mm256_cmpeq_epi64(zero, zero);
+	const __m256i shot = _mm256_set1_epi64x(bit);
+	for( int i=0; i<target.count; i+=4 ) {
+	    __m256i mask = _mm256_and_si256(shot, _mm256_loadu_si256((const __m256i*)(target.active+i)));
+	    __m256i left = _mm256_loadu_si256((const __m256i*)(target.left[word]+i));
+	    __m256i hit = _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_and_si256(left, mask), zero), ones);
+	    int hits = laneCount4(hit);
+	    if( hits == 0 ) continue;
+	    tally.hits += hits;
+
+	    left = _mm256_andnot_si256(mask, left);
+	    _mm256_storeu_si256((__m256i*)(target.left[word]+i), left);
+	    __m256i rest = _mm256_loadu_si256((const __m256i*)(target.left[1-word]+i));
+	    __m256i won = _mm256_and_si256(hit, _mm256_cmpeq_epi64(_mm256_or_si256(left, rest), zero));
+	    __m256i* wonAt = (__m256i*)(target.won+i);
+	    _mm256_storeu_si256(wonAt, _mm256_or_si256(_mm256_loadu_si256(wonAt), won));
+
+	    for( int ship=0; ship<target.numShips; ship++ ) {
+		__m256i* cellsAt = (__m256i*)(target.ships[ship][word]+i);
+		__m256i cells = _mm256_loadu_si256(cellsAt);
+		__m256i inShip = _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_and_si256(cells, mask), zero), ones);
+		if( _mm256_testz_si256(inShip, inShip) ) continue;
+		cells = _mm256_andnot_si256(mask, cells);
+		_mm256_storeu_si256(cellsAt, cells);
+		__m256i other = _mm256_loadu_si256((const __m256i*)(target.ships[ship][1-word]+i));
+		__m256i sunk = _mm256_cmpeq_epi64(_mm256_or_si256(cells, other), zero);
+		tally.kills += laneCount4(_mm256_and_si256(inShip, sunk));
+	    }
+	}
+    }
+
+    __attribute__((target("avx2")))
+    int retireAvx2( uint64_t* active, const uint64_t* won0, const uint64_t* won1,
+		    int64_t* moves, int step, int count )
+    {
+	const __m256i moveCount = _mm256_set1_epi64x(step+1);
+	int playing = 0;
+	for( int i=0; i<count; i+=4 ) {
+	    __m256i was = _mm256_loadu_si256((const __m256i*)(active+i));
+	    __m256i over = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(won0+i)),
+					   _mm256_loadu_si256((const __m256i*)(won1+i)));
+	    __m256i ended = _mm256_and_si256(was, over);
+	    __m256i now = _mm256_andnot_si256(over, was);
+	    _mm256_storeu_si256((__m256i*)(active+i), now);
+	    __m256i* movesAt = (__m256i*)(moves+i);
+	    _mm256_storeu_si256(movesAt, _mm256_blendv_epi8(_mm256_loadu_si256(movesAt), moveCount, ended));
+	    playing += laneCount4(now);
+	}
+	return playing;
+    }
+#endif
+
+    struct Kernels {
+	const char* name;
+	ShootFunction shoot;
+	RetireFunction retire;
+    };
+
+    const Kernels kernels[BatchSim::NumKernels] = {
+	{ "plain", shootPlain, retirePlain },
+#ifdef BATCHSIM_X86
+	{ "sse2", shootSse2, retireSse2 },
+	{ "avx2", shootAvx2, retireAvx2 },
+#else
+	{ "sse2", shootPlain, retirePlain },
+	{ "avx2", shootPlain, retirePlain },
+#endif
+    };
+
+    bool haveKernel( BatchSim::Kernel kernel ) {
+#ifdef BATCHSIM_X86
+	if( kernel == BatchSim::Avx2Kernel ) return __builtin_cpu_supports("avx2");
+	if( kernel == BatchSim::Sse2Kernel ) return __builtin_cpu_supports("sse2");
+	return true;
+#else
+	return kernel == BatchSim::PlainKernel;
+#endif
+    }
+}
+
+BatchSim::BatchSim( int boardSize, ScanOrder player1, ScanOrder player2 ) {
+    this->boardSize = boardSize;
+    numShips = boardSize-2 > MaxShips ? MaxShips : boardSize-2;
+    ScanPlayer::shotOrder(player1, boardSize, shots[0]);
+    ScanPlayer::shotOrder(player2, boardSize, shots[1]);
+    kernel = PlainKernel;
+    setKernel(Avx2Kernel);
+}
+
+BatchSim::Kernel BatchSim::setKernel( Kernel kernel ) {
+    while( kernel > PlainKernel && !haveKernel(kernel) ) {
+	kernel = Kernel(kernel-1);
+    }
+    this->kernel = kernel;
+    return kernel;
+}
+
+const char* BatchSim::kernelName( Kernel kernel ) {
+    return kernels[kernel].name;
+}
+
+/*
+ * Loads rounds firstRound... of job into the first lanes. A player whose
+ * fleet doesn't fit forfeits, as in AIContest::play(); those games and the
+ * spare lanes start out over.
+ */
+void BatchSim::setUp( const MatchJob& job, unsigned int seed, int firstRound, int lanes ) {
+    memset(left, 0, sizeof left);
+    memset(ships, 0, sizeof ships);
+    memset(active, 0, sizeof active);
+    memset(won, 0, sizeof won);
+    memset(moves, 0, sizeof moves);
+
+    for( int lane=0; lane<lanes; lane++ ) {
+	GameId game = { seed, job.pairing, firstRound+lane };
+	Random controller = Random::forGame(game, Random::Controller);
+	int lengths[MaxShips];
+	for( int i=0; i<numShips; i++ ) {
+	    lengths[i] = controller.below(MIN_SHIP_SIZE) + 3;
+	}
+
+	for( int side=0; side<2; side++ ) {
+	    uint64_t occupied[2] = { 0, 0 };
+	    bool placed = true;
+	    for( int i=0; placed && i<numShips; i++ ) {
+		int row, col;
+		Direction dir;
+		ScanPlayer::placement(i, row, col, dir);
+		int step = dir == Horizontal ? 1 : boardSize;
+		int end = (dir == Horizontal ? col : row) + lengths[i]-1;
+		placed = row >= 0 && row < boardSize && col >= 0 && col < boardSize && end < boardSize;
+		for( int n=0, cell=row*boardSize + col; placed && n<lengths[i]; n++, cell+=step ) {
+		    uint64_t bit = uint64_t(1) << (cell & 63);
+		    placed = !(occupied[cell >> 6] & bit);
+		    occupied[cell >> 6] |= bit;
+		    ships[side][i][cell >> 6][lane] |= bit;
+		}
+	    }
+	    if( !placed ) won[1-side][lane] = ~uint64_t(0);	// Forfeit
+	    left[side][0][lane] = occupied[0];
+	    left[side][1][lane] = occupied[1];
+	}
+	active[lane] = won[0][lane] | won[1][lane] ? 0 : ~uint64_t(0);
+    }
+}
+
+/*
+ * Plays the loaded games to the end, a move at a time, like AIContest::play().
+ */
+void BatchSim::run( ScanTally tally[2] ) {
+    const Kernels& use = kernels[kernel];
+    int maxShots = boardSize*boardSize*2;
+    Target targets[2];
+    for( int side=0; side<2; side++ ) {
+	Target& target = targets[side];	// Side's shots land on the other board
+	int board = 1-side;
+	target.left[0] = left[board][0];
+	target.left[1] = left[board][1];
+	for( int i=0; i<numShips; i++ ) {
+	    target.ships[i][0] = ships[board][i][0];
+	    target.ships[i][1] = ships[board][i][1];
+	}
+	target.numShips = numShips;
+	target.active = active;
+	target.won = won[side];
+	target.count = BatchSize;
+    }
+
+    int playing = 0;
+    for( int i=0; i<BatchSize; i++ ) {
+	if( active[i] ) playing++;
+    }
+    int step;
+    for( step=0; playing > 0 && step < maxShots; step++ ) {
+	for( int side=0; side<2; side++ ) {
+	    int cell = shots[side][step % shots[side].size()];
+	    use.shoot(targets[side], cell >> 6, uint64_t(1) << (cell & 63), tally[side]);
+	}
+	playing = use.retire(active, won[0], won[1], moves, step, BatchSize);
+    }
+    for( int i=0; i<BatchSize; i++ ) {
+	if( active[i] ) moves[i] = maxShots;	// Nobody won in time
+    }
+}
+
+MatchStats BatchSim::play( const MatchJob& job, unsigned int seed, ScanTally tally[2] ) {
+    MatchStats stats;
+    ScanTally counted[2];
+    for( int first=job.firstRound; first<job.firstRound+job.numRounds; first+=BatchSize ) {
+	int lanes = job.firstRound+job.numRounds - first;
+	if( lanes > BatchSize ) lanes = BatchSize;
+	setUp(job, seed, first, lanes);
+	run(counted);
+
+	// The same bookkeeping as MatchRunner::play().
+	for( int lane=0; lane<lanes; lane++ ) {
+	    bool player1Won = won[0][lane], player2Won = won[1][lane];
+	    int totalMoves = moves[lane];
+	    if((player1Won && player2Won) || !(player1Won || player2Won)) {
+		stats.ties++;
+		stats.shotsTaken[0] += totalMoves;
+		stats.gamesCounted[0]++;
+		stats.shotsTaken[1] += totalMoves;
+		stats.gamesCounted[1]++;
+	    } else if( player1Won ) {
+		stats.wins[0]++;
+		stats.shotsTaken[0] += totalMoves;
+		stats.gamesCounted[0]++;
+	    } else {
+		stats.wins[1]++;
+		stats.shotsTaken[1] += totalMoves;
+		stats.gamesCounted[1]++;
+	    }
+	}
+    }
+    if( tally ) {
+	tally[0] = counted[0];
+	tally[1] = counted[1];
+    }
+    return stats;
+}
@@ -0,0 +1,78 @@
+/**
+ * BatchSim.h: plays many games between two ScanPlayers at once.
+ * Date:       October 2026
+ *
+ * A scanner's shots don't depend on what they hit, so in every game of a
+ * match both players fire at the same cell on move n. BatchSim keeps a
+ * batch of games in structure-of-arrays form: for each board, each 64-bit
+ * word of its Bitboard and each ship, one array with a lane per game. A move
+ * then applies one shot to every lane at once, with AVX2 (4 lanes), SSE2
+ * (2 lanes) or plain code, chosen when the simulator is made:
+ *
+ *   - the shot is cleared from the lanes' unhit ship cells (a hit if it
+ *     was there),
+ *   - a ship whose cells are all clear is sunk,
+ *   - a board with no ship cells left is won.
+ *
+ * Games that are over are masked off until the whole batch is done. Fleets
+ * come from the game's controller stream and placements follow
+ * ScanPlayer::placement(), as in AIContest, so play() returns exactly the
+ * MatchStats MatchRunner::play() gives for the same job.
+ */
+
+#ifndef BATCHSIM_H		// Double inclusion protection
+#define BATCHSIM_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "MatchRunner.h"
+#include "ScanPlayer.h"
+#include "defines.h"
+
+using namespace std;
+
+class BatchSim {
+  public:
+    enum Kernel { PlainKernel, Sse2Kernel, Avx2Kernel, NumKernels };
+
+    /**
+     * @param boardSize Up to MAX_BOARD_SIZE (two words per board).
+     */
+    BatchSim( int boardSize, ScanOrder player1, ScanOrder player2 );
+
+    /**
+     * @brief Plays the rounds of job with the seed MatchRunner was given.
+     * @param tally If not null, receives each side's hits and kills.
+     */
+    MatchStats play( const MatchJob& job, unsigned int seed, ScanTally tally[2] = 0 );
+
+    /**
+     * @brief Uses the given kernel if this CPU has it.
+     * @return The kernel now in use.
+     */
+    Kernel setKernel( Kernel kernel );
+    static const char* kernelName( Kernel kernel );
+
+    static const int BatchSize = 512;	// Games in flight at once; a multiple of 4
+    static const int MaxShips = 6;	// As AIContest on boards up to MAX_BOARD_SIZE
+
+  private:
+    void setUp( const MatchJob& job, unsigned int seed, int firstRound, int lanes );
+    void run( ScanTally tally[2] );
+
+    int boardSize;
+    int numShips;
+    vector<int> shots[2];	// Cells each side fires at, in order
+    Kernel kernel;
+
+    // Per lane; index [board][word][lane] and [board][ship][word][lane]. Board
+    // b is the one side b's ships are on.
+    uint64_t left[2][2][BatchSize];		// Ship cells not hit yet
+    uint64_t ships[2][MaxShips][2][BatchSize];	// Each ship's cells not hit yet
+    uint64_t active[BatchSize];			// All ones while the game goes on
+    uint64_t won[2][BatchSize];			// All ones once side b has won
+    int64_t moves[BatchSize];
+};
+
+#endif
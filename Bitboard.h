@@ -0,0 +1,154 @@
+/**
+ * Bitboard.h: a 128-bit cell mask for boards up to 11x11.
+ * Date:       October 2026
+ *
+ * Cells are numbered row-major, index = row*boardSize + col, so a 10x10 board
+ * uses bits 0-99 and an 11x11 board bits 0-120. Everything is inline; the
+ * masks are plain values and are meant to be copied around freely.
+ *
+ * Bitboard64 is the same interface in a single word, for boards up to 8x8.
+ */
+
+#ifndef BITBOARD_H		// Double inclusion protection
+#define BITBOARD_H
+
+#include <stdint.h>
+
+class Bitboard {
+    public:
+	static const int Capacity = 128;	// Number of cells a mask can hold.
+
+	Bitboard() : lo(0), hi(0) {}
+	Bitboard( uint64_t lo, uint64_t hi ) : lo(lo), hi(hi) {}
+
+	/**
+	 * @brief Returns a mask with only the given cell set.
+	 * @param index Cell index, 0 <= index < Capacity.
+	 */
+	static Bitboard cell( int index ) {
+	    return index < 64 ? Bitboard( uint64_t(1) << index, 0 )
+	                      : Bitboard( 0, uint64_t(1) << (index-64) );
+	}
+
+	/**
+	 * @brief Returns a mask with cells [0, count) set.
+	 */
+	static Bitboard firstCells( int count ) {
+	    if( count <= 0 ) return Bitboard();
+	    if( count < 64 ) return Bitboard( (uint64_t(1) << count) - 1, 0 );
+	    if( count == 64 ) return Bitboard( ~uint64_t(0), 0 );
+	    if( count < 128 ) return Bitboard( ~uint64_t(0), (uint64_t(1) << (count-64)) - 1 );
+	    return Bitboard( ~uint64_t(0), ~uint64_t(0) );
+	}
+
+	bool test( int index ) const {
+	    return index < 64 ? (lo >> index) & 1 : (hi >> (index-64)) & 1;
+	}
+	void set( int index ) {
+	    if( index < 64 ) lo |= uint64_t(1) << index;
+	    else             hi |= uint64_t(1) << (index-64);
+	}
+	void reset( int index ) {
+	    if( index < 64 ) lo &= ~(uint64_t(1) << index);
+	    else             hi &= ~(uint64_t(1) << (index-64));
+	}
+
+	bool empty() const { return (lo | hi) == 0; }
+	bool any() const { return (lo | hi) != 0; }
+	int count() const { return __builtin_popcountll(lo) + __builtin_popcountll(hi); }
+
+	/**
+	 * @brief Returns the lowest set cell index, or -1 if the mask is empty.
+	 */
+	int first() const {
+	    if( lo ) return __builtin_ctzll(lo);
+	    if( hi ) return 64 + __builtin_ctzll(hi);
+	    return -1;
+	}
+
+	/**
+	 * @brief Clears and returns the lowest set cell index. Mask must not be empty.
+	 */
+	int popFirst() {
+	    int index = first();
+	    if( lo ) lo &= lo - 1;
+	    else     hi &= hi - 1;
+	    return index;
+	}
+
+	/**
+	 * @brief Returns true if this mask and the other share at least one cell.
+	 */
+	bool intersects( const Bitboard& other ) const {
+	    return ((lo & other.lo) | (hi & other.hi)) != 0;
+	}
+
+	/**
+	 * @brief Returns the cells of this mask that are not in the other one.
+	 */
+	Bitboard andNot( const Bitboard& other ) const {
+	    return Bitboard( lo & ~other.lo, hi & ~other.hi );
+	}
+
+	Bitboard operator&( const Bitboard& o ) const { return Bitboard( lo & o.lo, hi & o.hi ); }
+	Bitboard operator|( const Bitboard& o ) const { return Bitboard( lo | o.lo, hi | o.hi ); }
+	Bitboard operator^( const Bitboard& o ) const { return Bitboard( lo ^ o.lo, hi ^ o.hi ); }
+	Bitboard& operator&=( const Bitboard& o ) { lo &= o.lo; hi &= o.hi; return *this; }
+	Bitboard& operator|=( const Bitboard& o ) { lo |= o.lo; hi |= o.hi; return *this; }
+	Bitboard& operator^=( const Bitboard& o ) { lo ^= o.lo; hi ^= o.hi; return *this; }
+	bool operator==( const Bitboard& o ) const { return lo == o.lo && hi == o.hi; }
+	bool operator!=( const Bitboard& o ) const { return lo != o.lo || hi != o.hi; }
+
+	Bitboard wide() const { return *this; }
+
+	uint64_t lo;	// Cells 0-63
+	uint64_t hi;	// Cells 64-127
+};
+
+class Bitboard64 {
+    public:
+	static const int Capacity = 64;
+
+	Bitboard64() : bits(0) {}
+	explicit Bitboard64( uint64_t bits ) : bits(bits) {}
+
+	static Bitboard64 cell( int index ) { return Bitboard64( uint64_t(1) << index ); }
+	static Bitboard64 firstCells( int count ) {
+	    return Bitboard64( count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1 );
+	}
+
+	bool test( int index ) const { return (bits >> index) & 1; }
+	void set( int index ) { bits |= uint64_t(1) << index; }
+	void reset( int index ) { bits &= ~(uint64_t(1) << index); }
+
+	bool empty() const { return bits == 0; }
+	bool any() const { return bits != 0; }
+	int count() const { return __builtin_popcountll(bits); }
+	int first() const { return bits ? __builtin_ctzll(bits) : -1; }
+	int popFirst() {
+	    int index = __builtin_ctzll(bits);
+	    bits &= bits - 1;
+	    return index;
+	}
+
+	bool intersects( const Bitboard64& other ) const { return (bits & other.bits) != 0; }
+	Bitboard64 andNot( const Bitboard64& other ) const { return Bitboard64( bits & ~other.bits ); }
+
+	Bitboard64 operator&( const Bitboard64& o ) const { return Bitboard64( bits & o.bits ); }
+	Bitboard64 operator|( const Bitboard64& o ) const { return Bitboard64( bits | o.bits ); }
+	Bitboard64 operator^( const Bitboard64& o ) const { return Bitboard64( bits ^ o.bits ); }
+	Bitboard64& operator&=( const Bitboard64& o ) { bits &= o.bits; return *this; }
+	Bitboard64& operator|=( const Bitboard64& o ) { bits |= o.bits; return *this; }
+	Bitboard64& operator^=( const Bitboard64& o ) { bits ^= o.bits; return *this; }
+	bool operator==( const Bitboard64& o ) const { return bits == o.bits; }
+	bool operator!=( const Bitboard64& o ) const { return bits != o.bits; }
+
+	/**
+	 * @brief The same cells as a Bitboard.
+	 */
+	Bitboard wide() const { return Bitboard( bits, 0 ); }
+
+	uint64_t bits;
+};
+
+#endif
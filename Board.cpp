@@ -0,0 +1,31 @@
+/**
+ * Board.cpp: the Board<N> instantiations and the board factory.
+ * Date:      October 2026
+ */
+
+#include "Board.h"
+#include "BoardV3.h"
+#include "LargeBoard.h"
+
+template class Board<3>;
+template class Board<4>;
+template class Board<5>;
+template class Board<6>;
+template class Board<7>;
+template class Board<8>;
+template class Board<9>;
+template class Board<10>;
+
+BoardFactory boardFactory( int boardSize ) {
+    switch( boardSize ) {
+	case 3: return &Board<3>::create;
+	case 4: return &Board<4>::create;
+	case 5: return &Board<5>::create;
+	case 6: return &Board<6>::create;
+	case 7: return &Board<7>::create;
+	case 8: return &Board<8>::create;
+	case 9: return &Board<9>::create;
+	case 10: return &Board<10>::create;
+	default: return boardSize > MAX_BOARD_SIZE ? &LargeBoard::create : &BoardV3::create;
+    }
+}
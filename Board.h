@@ -0,0 +1,155 @@
+/**
+ * Board.h: BoardV3 with the board size fixed at compile time.
+ * Date:    October 2026
+ *
+ * Board<N> plays exactly like BoardV3(N) (same answers, same ship marks,
+ * same complaints about bad placements), but N is a constant: bounds checks,
+ * cell indexes and ship masks fold to constants, and boards up to 8x8 keep
+ * their masks in one 64-bit word (Bitboard64). boardFactory() (Board.cpp)
+ * picks the instantiation for a board size from 3 to 10.
+ */
+
+#ifndef BOARD_H		// Double inclusion protection
+#define BOARD_H
+
+#include <iostream>
+#include <cstring>
+#include <type_traits>
+
+#include "GameBoard.h"
+#include "Bitboard.h"
+#include "defines.h"
+
+using namespace std;
+
+template <int N>
+class Board: public GameBoard {
+    public:
+	static const int Cells = N*N;
+	static const int MaxShips = Cells/MIN_SHIP_SIZE;
+	typedef typename conditional<Cells <= 64, Bitboard64, Bitboard>::type Mask;
+
+	Board() {
+	    clear();
+	}
+
+	static GameBoard* create( int ) { return new Board<N>(); }
+
+	void clear() override {
+	    numShips = 0;
+	    occupied = shots = sunk = Mask();
+	    memset(shipAt, -1, sizeof shipAt);
+	}
+
+	bool placeShip(int row, int col, int length, Direction dir) override {
+	    bool horiz = dir==Horizontal;
+	    if( !positionOk(row, col, length, horiz) ) return false;
+	    Mask mask = shipMask(row, col, length, horiz);
+	    ships[numShips] = mask;
+	    occupied |= mask;
+	    while( mask.any() ) {
+		shipAt[mask.popFirst()] = numShips;
+	    }
+	    numShips++;
+	    return true;
+	}
+
+	char getOpponentView(int row, int col) override {
+	    int cell = row*N + col;
+	    if( !shots.test(cell) ) return WATER;
+	    if( !occupied.test(cell) ) return MISS;
+	    return sunk.test(cell) ? KILL : HIT;
+	}
+
+	char getOwnerView(int row, int col) override {
+	    int cell = row*N + col;
+	    if( occupied.test(cell) && !shots.test(cell) ) return getShipMark(row, col);
+	    return getOpponentView(row, col);
+	}
+
+	char getShipMark(int row, int col) override {
+	    int ship = shipAt[row*N + col];
+	    return ship < 0 ? WATER : char('a' + ship);
+	}
+
+	ShipLocation getShip(int row, int col) override {
+	    ShipLocation location = { row, col, 0, None };
+	    if( !onBoard(row, col) || shipAt[row*N + col] < 0 ) return location;
+	    const Mask& cells = ships[shipAt[row*N + col]];
+	    int first = cells.first();
+	    location.row = first / N;
+	    location.col = first % N;
+	    location.length = cells.count();
+	    location.dir = cells.test(first+1) ? Horizontal : Vertical;
+	    return location;
+	}
+
+	Bitboard getShipCells(int row, int col) override {
+	    if( !onBoard(row, col) ) return Bitboard();
+	    int ship = shipAt[row*N + col];
+	    return ship < 0 ? Bitboard() : ships[ship].wide();
+	}
+
+	char processShot(int row, int col) override {
+	    if( !onBoard(row, col) ) return INVALID_SHOT;
+	    int cell = row*N + col;
+	    if( shots.test(cell) ) return DUPLICATE_SHOT;
+	    shots.set(cell);
+
+	    int ship = shipAt[cell];
+	    if( ship < 0 ) return MISS;
+	    if( ships[ship].andNot(shots).empty() ) {
+		sunk |= ships[ship];
+		return KILL;
+	    }
+	    return HIT;
+	}
+
+	bool hasWon() override {
+	    return occupied.andNot(shots).empty();
+	}
+
+    private:
+	static bool onBoard(int row, int col) {
+	    // One unsigned compare per coordinate.
+	    return unsigned(row) < unsigned(N) && unsigned(col) < unsigned(N);
+	}
+
+	bool positionOk(int row, int col, int length, bool horiz) {
+	    if( numShips >= MaxShips ) {
+		cerr << "positionOk: no room for another ship" << endl;
+		return false;
+	    }
+	    int end = (horiz ? col : row) + length-1;
+	    if( !onBoard(row, col) || end >= N ) {
+		cerr << "positionOk: " << (horiz ? "horizontal" : "vertical") << " position invalid" << endl;
+		return false;
+	    }
+	    Mask collision = shipMask(row, col, length, horiz) & occupied;
+	    if( collision.any() ) {
+		int cell = collision.first();
+		cerr << "positionOk: " << (horiz ? "horizontal" : "vertical") << " collision at row="
+		     << cell/N << ", col=" << cell%N << endl;
+		return false;
+	    }
+	    return true;
+	}
+
+	static Mask shipMask(int row, int col, int length, bool horiz) {
+	    Mask mask;
+	    int step = horiz ? 1 : N;
+	    for(int i=0, cell=row*N + col; i<length; i++, cell+=step) {
+		mask.set(cell);
+	    }
+	    return mask;
+	}
+
+	Mask occupied;			// Cells covered by any ship
+	Mask shots;			// Cells the opponent has fired at
+	Mask sunk;			// Cells belonging to sunk ships
+	Mask ships[MaxShips];		// One mask per placed ship, in placement order
+	signed char shipAt[Cells];	// Index into ships[], -1 for water
+	int numShips;
+};
+
+#endif
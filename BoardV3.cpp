@@ -1,14 +1,15 @@
 /**
  * @author Stefan Brandle and Jonathan Geisler
  * @date August, 2004
- * Shell for BoardV3.cpp implementations.
- * Please type in your name[s] below:
- *
+ * Bitboard implementation of BoardV3.
  *
+ * Ship marks are 'a' for the first ship placed, 'b' for the second, and so
+ * on, exactly as in the char-array version (ReferenceBoardV3).
  */
 
 #include <iostream>
 #include <stdlib.h>
+#include <string.h>
 
 #include "BoardV3.h"
 #include "defines.h"
@@ -16,12 +17,18 @@
 using namespace std;
 
 BoardV3::BoardV3(int width) {
-    shipMark = 'a';
     boardSize = width;
+    clear();
+}
 
-    // Initialize the boards
-    initialize(shotBoard);
-    initialize(shipBoard);
+/*
+ * Takes the ships off and forgets the shots, so the board can be used for
+ * another game.
+ */
+void BoardV3::clear() {
+    numShips = 0;
+    occupied = shots = sunk = Bitboard();
+    memset(shipAt, -1, sizeof shipAt);
 }
 
 BoardV3::BoardV3(const BoardV3& other) {
@@ -32,15 +39,15 @@ void BoardV3::operator=(const BoardV3& other) {
     // Avoid setting yourself to yourself.
     if( this == &other) return;
 
-    shipMark = other.shipMark;    
     boardSize = other.boardSize;
-
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    shipBoard[row][col] = other.shipBoard[row][col];
-	    shotBoard[row][col] = other.shotBoard[row][col];
-	}
+    numShips = other.numShips;
+    occupied = other.occupied;
+    shots = other.shots;
+    sunk = other.sunk;
+    for(int i=0; i<numShips; i++) {
+	ships[i] = other.ships[i];
     }
+    memcpy(shipAt, other.shipAt, sizeof shipAt);
 }
 
 bool BoardV3::placeShip(int row, int col, int length, Direction dir) {
@@ -54,73 +61,107 @@ bool BoardV3::placeShip(int row, int col, int length, Direction dir) {
 }
 
 bool BoardV3::positionOk( int row, int col, int length, bool horiz  ) {
+    if( numShips >= MaxShips ) {
+	cerr << "positionOk: no room for another ship" << endl;
+	return false;
+    }
+
     if( horiz ) {
 	// If starting point off board, of would go off board, instant false.
 	if( row<0 || row>=boardSize || col<0 || col+length-1>=boardSize ) {
 	    cerr << "positionOk: horizontal position invalid" << endl;
 	    return false;
 	}
-
-	for(int c=col; c<col+length; c++) {
-	    if(shotBoard[row][c] == SHIP) {
-		cerr << "positionOk: horizontal collision at row=" << row << ", col="  << c << endl;
-		return false;
-	    }
-	}
     } else {
 	// If starting point off board, of would go off board, instant false.
 	if( col<0 || col>=boardSize || row<0 || row+length-1>=boardSize ) {
 	    cerr << "positionOk: vertical position invalid" << endl;
 	    return false;
 	}
+    }
 
-	for(int r=row; r<row+length; r++) {
-	    if(shotBoard[r][col] == SHIP) {
-		cerr << "positionOk: horizontal collision at row=" << r << ", col="  << col << endl;
-		return false;
-	    }
-	}
+    Bitboard collision = shipMask(row, col, length, horiz) & occupied;
+    if( collision.any() ) {
+	int cell = collision.first();
+	cerr << "positionOk: " << (horiz ? "horizontal" : "vertical") << " collision at row="
+	     << cell/boardSize << ", col=" << cell%boardSize << endl;
+	return false;
     }
     return true;
 }
 
+/*
+ * Builds the mask covering a ship. The position must already be on the board.
+ */
+Bitboard BoardV3::shipMask( int row, int col, int length, bool horiz ) {
+    Bitboard mask;
+    int step = horiz ? 1 : boardSize;
+    for(int i=0, cell=cellIndex(row, col); i<length; i++, cell+=step) {
+	mask.set(cell);
+    }
+    return mask;
+}
+
 void BoardV3::markShip( int row, int col, int length, bool horiz ) {
-    if( horiz ) {
-	for(int c=col; c<col+length; c++) {
-	    shipBoard[row][c] = shipMark;
-	    shotBoard[row][c] = SHIP;
-	}
-    } else {
-	for(int r=row; r<row+length; r++) {
-	    shipBoard[r][col] = shipMark;
-	    shotBoard[r][col] = SHIP;
-	}
+    Bitboard mask = shipMask(row, col, length, horiz);
+    ships[numShips] = mask;
+    occupied |= mask;
+    while( mask.any() ) {
+	shipAt[mask.popFirst()] = numShips;
     }
 
-    shipMark ++;	// Increment shipMark to next avail value
+    numShips++;		// Next ship gets the next mark
 }
 
 char BoardV3::getOpponentView(int row, int col) {
-    char value = shotBoard[row][col];
-    switch (value) {
-        case HIT:
-        case MISS:
-        case KILL:
-    	    return value;
-        default:
-    	    return WATER;
-    }
+    int cell = cellIndex(row, col);
+    if( !shots.test(cell) )
+	return WATER;
+    if( !occupied.test(cell) )
+	return MISS;
+    return sunk.test(cell) ? KILL : HIT;
 }
 
 char BoardV3::getOwnerView(int row, int col) {
-    if( shotBoard[row][col] == SHIP )
-        return shipBoard[row][col];
+    int cell = cellIndex(row, col);
+    if( occupied.test(cell) && !shots.test(cell) )
+        return getShipMark(row, col);
     else
-        return shotBoard[row][col];
+        return getOpponentView(row, col);
 }
 
 char BoardV3::getShipMark(int row, int col) {
-    return shipBoard[row][col];
+    int ship = shipAt[cellIndex(row, col)];
+    return ship < 0 ? WATER : char('a' + ship);
+}
+
+/**
+ * Returns where the ship covering row/col lies, length 0 for water.
+ */
+ShipLocation BoardV3::getShip(int row, int col) {
+    ShipLocation location = { row, col, 0, None };
+    Bitboard cells = getShipCells(row, col);
+    if( cells.any() ) {
+	int first = cells.first();
+	location.row = first / boardSize;
+	location.col = first % boardSize;
+	location.length = cells.count();
+	// A vertical ship's next cell is a whole row further on.
+	location.dir = cells.test(first+1) ? Horizontal : Vertical;
+    }
+    return location;
+}
+
+/**
+ * Returns every cell of the ship covering row/col (cell index row*size+col),
+ * or an empty mask for water.
+ */
+Bitboard BoardV3::getShipCells(int row, int col) {
+    if( row<0 || row>= boardSize || col<0 || col>=boardSize ) {
+	return Bitboard();
+    }
+    int ship = shipAt[cellIndex(row, col)];
+    return ship < 0 ? Bitboard() : ships[ship];
 }
 
 char BoardV3::processShot(int row, int col) {
@@ -129,69 +170,32 @@ char BoardV3::processShot(int row, int col) {
 	return INVALID_SHOT;
     }
 
-    switch(shotBoard[row][col]) {
-	case WATER:
-	    shotBoard[row][col] = MISS;
-	    return MISS;
-	case MISS:
-	case HIT:
-	case KILL:
-	    return DUPLICATE_SHOT;
-	case SHIP:
-	    shotBoard[row][col] = HIT;
-	    if(isSunk(row,col)) {
-	        markSunk(row,col);
-		return KILL;
-	    } else {
-	        return HIT;
-	    };
-	default:
-	    cerr << "This didn't happen!!!!" << endl
-	         << shotBoard << "[" <<row<<"]["<<col<<"] had value " 
-	         << shotBoard[row][col] << endl;
-	    break;
+    int cell = cellIndex(row, col);
+    if( shots.test(cell) ) {
+	return DUPLICATE_SHOT;
     }
-    return MISS;
-}
+    shots.set(cell);
 
-bool BoardV3::isSunk(int row, int col) {
-    char mark = shipBoard[row][col];
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    if(shipBoard[row][col]==mark && shotBoard[row][col]==SHIP) {
-		return false;
-	    }
-	}
+    int ship = shipAt[cell];
+    if( ship < 0 ) {
+	return MISS;
     }
-    return true;
-}
-
-void BoardV3::markSunk(int row, int col) {
-    char mark = shipBoard[row][col];
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    if(shipBoard[row][col]==mark) {
-	        shotBoard[row][col]=KILL;
-	    }
-	}
+    if( isSunk(ship) ) {
+	markSunk(ship);
+	return KILL;
     }
+    return HIT;
 }
 
-
-bool BoardV3::hasWon() {
-    for(int row=0; row<boardSize; row++) {
-	for(int col=0; col<boardSize; col++) {
-	    if(shotBoard[row][col]==SHIP) {
-	    	return false;	// Found an unsunk bit of SHIP, haven't won.
-	    }
-	}
-    }
-    return true;	// In absence of evidence to contrary, have won.
+bool BoardV3::isSunk(int ship) {
+    return ships[ship].andNot(shots).empty();
 }
 
-void BoardV3::initialize(char board[MaxBoardSize][MaxBoardSize]) {
-    for(int row=0; row<MaxBoardSize; row++)
-        for(int col=0; col<MaxBoardSize; col++)
-            board[row][col] = WATER;
+void BoardV3::markSunk(int ship) {
+    sunk |= ships[ship];
 }
 
+bool BoardV3::hasWon() {
+    // Won once no occupied cell is left unshot.
+    return occupied.andNot(shots).empty();
+}
@@ -2,51 +2,58 @@
  * Authors Stefan Brandle and Jonathan Geisler
  * Date    November, 2004
  * Declaration source file for BoardV3.
- * Please type in your name[s] below:
  *
+ * The board is kept as bitboards: one mask per ship plus masks for all
+ * occupied cells, all shots taken and all sunk cells. Shot resolution,
+ * sunk checks and the win check are mask tests instead of board scans.
+ * ReferenceBoardV3 holds the original char-array implementation.
  */
 
 #ifndef BOARDV3_H
 #define BOARDV3_H
 
 #include "defines.h"
+#include "Bitboard.h"
+#include "GameBoard.h"
 
 using namespace std;
 
-class BoardV3 {
+class BoardV3: public GameBoard {
     public:
 	// Constructors and such
-	BoardV3( int width);		
+	BoardV3( int width);
 	BoardV3(const BoardV3& other);
 	void operator=(const BoardV3& other);
+	static GameBoard* create( int width ) { return new BoardV3(width); }
 	// General public access functions.
-	bool placeShip(int row, int col, int length, Direction dir);
-    	char getOpponentView(int row, int col);
-    	char getOwnerView(int row, int col);
-    	char getShipMark(int row, int col);
-    	char processShot(int row, int col);
-    	bool hasWon();
+	bool placeShip(int row, int col, int length, Direction dir) override;
+    	char getOpponentView(int row, int col) override;
+    	char getOwnerView(int row, int col) override;
+    	char getShipMark(int row, int col) override;
+    	ShipLocation getShip(int row, int col) override;
+    	Bitboard getShipCells(int row, int col) override;
+    	char processShot(int row, int col) override;
+    	bool hasWon() override;
+    	void clear() override;
 
         const static int MaxBoardSize = 10;     // Maximum board size.
+        const static int MaxShips = MaxBoardSize*MaxBoardSize/MIN_SHIP_SIZE;
 
     private:
-	// Put prototypes for your private helper functions here.
-	void initialize(char board[MaxBoardSize][MaxBoardSize]);
 	bool positionOk(int row, int col, int length, bool horiz);
 	void markShip(int row, int col, int length, bool horiz);
-        bool isSunk(int row, int col);
-        void markSunk(int row, int col);
-
-	// Suggested data variables. Although you can ignore these, it
-	// is suggested that you use them. If you change the array definitions,
-	// you may have to change some of the prototypes or code that 
-	// you are given as part of your starter kit.
-	char shipBoard[MaxBoardSize][MaxBoardSize];    // Tracks the placed ships and shots
-	char shotBoard[MaxBoardSize][MaxBoardSize];    // Tracks where ships are through whole game
+	Bitboard shipMask(int row, int col, int length, bool horiz);
+        bool isSunk(int ship);
+        void markSunk(int ship);
+	int cellIndex(int row, int col) { return row*boardSize + col; }
+
+	Bitboard occupied;		    // Cells covered by any ship
+	Bitboard shots;			    // Cells the opponent has fired at
+	Bitboard sunk;			    // Cells belonging to sunk ships
+	Bitboard ships[MaxShips];	    // One mask per placed ship, in placement order
+	signed char shipAt[MaxBoardSize*MaxBoardSize];	// Index into ships[], -1 for water
+	int numShips;			    // Ships placed so far
 	int boardSize;		    // Tracks how many rows/cols are actually being used.
-
-	// Put your private data variables here.
-	char shipMark;		    // Used to mark the ships on shipBoard
 };
 
 #endif	// End of multiple inclusion control.
@@ -0,0 +1,68 @@
+/**
+ * DensityPlayer.cpp: a player that shoots where ships are most likely to be.
+ * Date:              October 2026
+ */
+
+#include "DensityPlayer.h"
+
+DensityPlayer::DensityPlayer( int boardSize )
+    :PackedPlayerV2(boardSize), targeter(boardSize)
+{
+}
+
+DensityPlayer::~DensityPlayer() {
+}
+
+void DensityPlayer::newRound() {
+    targeter.newRound();
+    ownShips = Bitboard();
+}
+
+/**
+ * @brief Places the ship at a random free spot. The opponent's fleet has the
+ * same lengths as ours, so this is also how the targeter learns the fleet.
+ */
+PackedMessage DensityPlayer::placePackedShip( int length ) {
+    targeter.addShip(length);
+
+    int free = 0;
+    for( int i=0; i<targeter.numPlacements(length); i++ ) {
+	if( !targeter.placement(length, i).intersects(ownShips) ) free++;
+    }
+    int pick = free > 0 ? rng.below(free) : 0;
+    for( int i=0; i<targeter.numPlacements(length); i++ ) {
+	const Bitboard& mask = targeter.placement(length, i);
+	if( mask.intersects(ownShips) || pick-- > 0 ) continue;
+
+	ownShips |= mask;
+	int first = mask.first();
+	Direction dir = mask.test(first+1) ? Horizontal : Vertical;
+	return PackedMessage( PLACE_SHIP, first / boardSize, first % boardSize, dir, length );
+    }
+    return PackedMessage( PLACE_SHIP, -1, -1, Horizontal, length );	// No room at all
+}
+
+PackedMessage DensityPlayer::getPackedMove() {
+    int cell = targeter.bestCell(rng);
+    if( cell < 0 ) {
+	return PackedMessage( SHOT, 0, 0, None, 1 );
+    }
+    return PackedMessage( SHOT, cell / boardSize, cell % boardSize, None, 1 );
+}
+
+void DensityPlayer::updatePacked( PackedMessage msg ) {
+    switch( msg.getMessageType() ) {
+	case MISS:
+	    targeter.miss(msg.getRow(), msg.getCol());
+	    break;
+	case HIT:
+	    targeter.hit(msg.getRow(), msg.getCol());
+	    break;
+	default:	// KILLs come through updateKill()
+	    break;
+    }
+}
+
+void DensityPlayer::updateKill( const ShipKill& kill ) {
+    targeter.sunk(kill.cells);
+}
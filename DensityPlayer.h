@@ -0,0 +1,33 @@
+/**
+ * DensityPlayer.h: a player that shoots where ships are most likely to be.
+ * Date:            October 2026
+ *
+ * Shots come from a DensityTargeter. Ships are placed uniformly at random
+ * among the legal placements, using the targeter's placement masks.
+ */
+
+#ifndef DENSITYPLAYER_H		// Double inclusion protection
+#define DENSITYPLAYER_H
+
+using namespace std;
+
+#include "PackedPlayerV2.h"
+#include "DensityTargeter.h"
+#include "defines.h"
+
+class DensityPlayer: public PackedPlayerV2 {
+    public:
+	DensityPlayer( int boardSize );
+	~DensityPlayer();
+	void newRound() override;
+	PackedMessage placePackedShip(int length) override;
+	PackedMessage getPackedMove() override;
+	void updatePacked(PackedMessage msg) override;
+	void updateKill(const ShipKill& kill) override;
+
+    private:
+	DensityTargeter targeter;
+	Bitboard ownShips;	// Cells taken by our own ships this round
+};
+
+#endif
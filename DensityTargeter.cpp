@@ -0,0 +1,142 @@
+/**
+ * DensityTargeter.cpp: probability density targeting over precomputed ship placements.
+ * Date:                October 2026
+ */
+
+#include "DensityTargeter.h"
+
+DensityTargeter::DensityTargeter( int boardSize ) {
+    this->boardSize = boardSize;
+
+    // Every horizontal, then every vertical position of each ship length.
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	placementCount[length] = 0;
+	if( length < MIN_SHIP_SIZE || length > boardSize ) continue;
+	for( int row=0; row<boardSize; row++ ) {
+	    for( int col=0; col+length<=boardSize; col++ ) {
+		Bitboard mask;
+		for( int i=0; i<length; i++ ) mask.set(row*boardSize + col+i);
+		placements[length][placementCount[length]++] = mask;
+	    }
+	}
+	for( int row=0; row+length<=boardSize; row++ ) {
+	    for( int col=0; col<boardSize; col++ ) {
+		Bitboard mask;
+		for( int i=0; i<length; i++ ) mask.set((row+i)*boardSize + col);
+		placements[length][placementCount[length]++] = mask;
+	    }
+	}
+    }
+    newRound();
+}
+
+void DensityTargeter::newRound() {
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	for( int i=0; i<placementCount[length]; i++ ) alive[length][i] = i;
+	aliveCount[length] = placementCount[length];
+	shipsLeft[length] = 0;
+    }
+    shots = Bitboard();
+    hits = Bitboard();
+}
+
+void DensityTargeter::addShip( int length ) {
+    if( length >= MIN_SHIP_SIZE && length <= MAX_SHIP_SIZE ) {
+	shipsLeft[length]++;
+    }
+}
+
+void DensityTargeter::miss( int row, int col ) {
+    Bitboard cell = Bitboard::cell(row*boardSize + col);
+    shots |= cell;
+    dropPlacements(cell);
+}
+
+void DensityTargeter::hit( int row, int col ) {
+    Bitboard cell = Bitboard::cell(row*boardSize + col);
+    shots |= cell;
+    hits |= cell;
+}
+
+void DensityTargeter::sunk( const Bitboard& cells ) {
+    shots |= cells;
+    hits = hits.andNot(cells);
+    int length = cells.count();
+    if( length <= MAX_SHIP_SIZE && shipsLeft[length] > 0 ) {
+	shipsLeft[length]--;
+    }
+    // Ships don't overlap, so nothing else can use these cells.
+    dropPlacements(cells);
+}
+
+/*
+ * Removes the placements that use any of the cells. Order doesn't matter,
+ * so each removal moves the last live placement into the gap.
+ */
+void DensityTargeter::dropPlacements( const Bitboard& cells ) {
+    for( int length=MIN_SHIP_SIZE; length<=MAX_SHIP_SIZE; length++ ) {
+	short* live = alive[length];
+	int count = aliveCount[length];
+	for( int i=0; i<count; ) {
+	    if( placements[length][live[i]].intersects(cells) ) {
+		live[i] = live[--count];
+	    } else {
+		i++;
+	    }
+	}
+	aliveCount[length] = count;
+    }
+}
+
+/*
+ * Adds every live placement of the ships still afloat to cellDensity. When
+ * targeting, only placements through unsunk hits count, and a placement
+ * that explains more of the hits counts more.
+ */
+void DensityTargeter::addDensity( bool targeting ) {
+    for( int length=MIN_SHIP_SIZE; length<=MAX_SHIP_SIZE; length++ ) {
+	if( shipsLeft[length] == 0 ) continue;
+	const short* live = alive[length];
+	for( int i=0; i<aliveCount[length]; i++ ) {
+	    const Bitboard& mask = placements[length][live[i]];
+	    int weight = shipsLeft[length];
+	    if( targeting ) {
+		int covered = (mask & hits).count();
+		if( covered == 0 ) continue;
+		weight *= covered*covered;
+	    }
+	    Bitboard open = mask.andNot(shots);
+	    while( open.any() ) {
+		cellDensity[open.popFirst()] += weight;
+	    }
+	}
+    }
+}
+
+int DensityTargeter::bestCell( Random& rng ) {
+    int numCells = boardSize*boardSize;
+    for( int cell=0; cell<numCells; cell++ ) cellDensity[cell] = 0;
+    addDensity( hits.any() );
+
+    int best = -1;
+    for( int pass=0; pass<2 && best < 0; pass++ ) {
+	if( pass == 1 ) {
+	    // Nothing through the hits fits (or nothing fits at all): hunt
+	    // with whatever is left, or just take any open cell.
+	    addDensity(false);
+	}
+	int bestDensity = 0, ties = 0;
+	for( int cell=0; cell<numCells; cell++ ) {
+	    if( shots.test(cell) || cellDensity[cell] < bestDensity ) continue;
+	    if( cellDensity[cell] > bestDensity || best < 0 ) {
+		best = cell;
+		bestDensity = cellDensity[cell];
+		ties = 1;
+	    } else if( rng.below(++ties) == 0 ) {
+		best = cell;	// Each of the tied cells is equally likely
+	    }
+	}
+	if( pass == 0 && bestDensity == 0 ) best = -1;
+    }
+    return best;
+}
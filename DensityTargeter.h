@@ -0,0 +1,77 @@
+/**
+ * DensityTargeter.h: probability density targeting over precomputed ship placements.
+ * Date:              October 2026
+ *
+ * Every way a ship of each length can lie on the board is computed once, as
+ * a Bitboard. During a round the targeter keeps, per ship length, the list
+ * of placements that are still possible: a miss or a sunk ship removes every
+ * placement touching it. The density of a cell is the number of live
+ * placements of the ships still afloat that cover it. While there are hits
+ * on ships that are not yet sunk, only placements through those hits count,
+ * weighted by how many of the hits they explain.
+ *
+ * The fleet (ship lengths) is whatever addShip() was told: in this game both
+ * players get the same lengths, so a player learns them from placeShip().
+ */
+
+#ifndef DENSITYTARGETER_H		// Double inclusion protection
+#define DENSITYTARGETER_H
+
+#include "defines.h"
+#include "Bitboard.h"
+#include "Random.h"
+
+class DensityTargeter {
+    public:
+	DensityTargeter( int boardSize );
+
+	/**
+	 * @brief Forgets all shots and the fleet; every placement is possible again.
+	 */
+	void newRound();
+
+	/**
+	 * @brief Adds a ship of the given length to the fleet being hunted.
+	 */
+	void addShip( int length );
+
+	// Shot results.
+	void miss( int row, int col );
+	void hit( int row, int col );
+	void sunk( const Bitboard& cells );	// Every cell of the sunk ship
+
+	/**
+	 * @brief Returns the unshot cell with the highest density (row*boardSize+col),
+	 * ties broken by rng, or -1 if every cell has been shot.
+	 */
+	int bestCell( Random& rng );
+
+	/**
+	 * @brief Density of a cell as computed by the last bestCell().
+	 */
+	int density( int row, int col ) const { return cellDensity[row*boardSize + col]; }
+
+	// The precomputed placements of a ship length, and how many are still possible.
+	int numPlacements( int length ) const { return placementCount[length]; }
+	const Bitboard& placement( int length, int index ) const { return placements[length][index]; }
+	int placementsLeft( int length ) const { return aliveCount[length]; }
+
+	static const int MaxPlacements = 2*MAX_BOARD_SIZE*MAX_BOARD_SIZE;
+
+    private:
+	void dropPlacements( const Bitboard& cells );
+	void addDensity( bool targeting );
+
+	int boardSize;
+	Bitboard placements[MAX_SHIP_SIZE+1][MaxPlacements];	// By length
+	int placementCount[MAX_SHIP_SIZE+1];
+	short alive[MAX_SHIP_SIZE+1][MaxPlacements];	// Indexes of still possible placements
+	int aliveCount[MAX_SHIP_SIZE+1];
+	int shipsLeft[MAX_SHIP_SIZE+1];			// Fleet still afloat, by length
+
+	Bitboard shots;		// Every cell shot at
+	Bitboard hits;		// Hits on ships that are not sunk yet
+	int cellDensity[Bitboard::Capacity];
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * Diagnostics.cpp: asynchronous diagnostic files for players.
+ * Date:            October 2026
+ */
+
+#include "Diagnostics.h"
+
+#ifndef NO_DIAGNOSTICS
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <pthread.h>
+
+namespace Diagnostics {
+    namespace {
+	struct Record {
+	    const char* fileName;
+	    bool append;
+	    string text;
+	};
+
+	/*
+	 * Bounded multi-producer queue (Vyukov): each slot's sequence number
+	 * says whether it is free for the producer at position pos (== pos)
+	 * or holds the record for the consumer at pos (== pos+1). Only the
+	 * background thread pops.
+	 */
+	class Queue {
+	  public:
+	    Queue() : pushPos(0), popPos(0) {
+		for( int i=0; i<QueueSize; i++ ) slots[i].sequence.store(i, memory_order_relaxed);
+	    }
+
+	    bool push( Record& record ) {
+		size_t pos = pushPos.load(memory_order_relaxed);
+		for( ;; ) {
+		    Slot& slot = slots[pos & (QueueSize-1)];
+		    long diff = long(slot.sequence.load(memory_order_acquire)) - long(pos);
+		    if( diff == 0 ) {
+			if( pushPos.compare_exchange_weak(pos, pos+1, memory_order_relaxed) ) break;
+		    } else if( diff < 0 ) {
+			return false;	// Full
+		    } else {
+			pos = pushPos.load(memory_order_relaxed);
+		    }
+		}
+		Slot& slot = slots[pos & (QueueSize-1)];
+		slot.record.fileName = record.fileName;
+		slot.record.append = record.append;
+		slot.record.text.swap(record.text);
+		slot.sequence.store(pos+1, memory_order_release);
+		return true;
+	    }
+
+	    bool pop( Record& record ) {
+		Slot& slot = slots[popPos & (QueueSize-1)];
+		if( slot.sequence.load(memory_order_acquire) != popPos+1 ) return false;
+		record.fileName = slot.record.fileName;
+		record.append = slot.record.append;
+		record.text.swap(slot.record.text);
+		slot.sequence.store(popPos + QueueSize, memory_order_release);
+		popPos++;
+		return true;
+	    }
+
+	  private:
+	    struct Slot {
+		atomic<size_t> sequence;
+		Record record;
+	    };
+	    Slot slots[QueueSize];
+	    atomic<size_t> pushPos;
+	    size_t popPos;		// Background thread only
+	};
+
+	/*
+	 * The queue plus the thread that drains it. Built on first use; its
+	 * destructor (at exit, through SinkOwner) stops the thread and writes
+	 * what is left.
+	 */
+	class Sink {
+	  public:
+	    Sink() : stopping(false), flushRequests(0), flushesDone(0), dropped(0) {
+		worker = thread(&Sink::run, this);
+	    }
+
+	    ~Sink() {
+		stopping = true;
+		worker.join();
+		if( dropped > 0 ) {
+		    cerr << "Diagnostics: " << dropped << " records dropped (queue full)" << endl;
+		}
+	    }
+
+	    void add( const char* fileName, bool append, const string& text ) {
+		Record record = { fileName, append, text };
+		// When full, give the writer thread a moment (it may be sharing
+		// our core) rather than drop the record straight away.
+		for( int attempt=0; !queue.push(record); attempt++ ) {
+		    if( attempt == 3 ) {
+			dropped++;
+			return;
+		    }
+		    this_thread::yield();
+		}
+	    }
+
+	    void flush() {
+		long request = ++flushRequests;
+		while( flushesDone.load() < request ) {
+		    this_thread::sleep_for(chrono::milliseconds(1));
+		}
+	    }
+
+	  private:
+	    struct Pending {
+		Pending() : replace(false) {}
+		bool replace;	// Truncate the file first, else append
+		string text;
+	    };
+
+	    void run() {
+		chrono::steady_clock::time_point nextFlush = chrono::steady_clock::now();
+		bool last = false;
+		while( !last ) {
+		    last = stopping;	// One more pass after the stop request
+		    long request = flushRequests.load();
+		    bool idle = !drain();
+		    if( last || request > flushesDone.load() || chrono::steady_clock::now() >= nextFlush ) {
+			writeFiles();
+			flushesDone.store(request);
+			nextFlush = chrono::steady_clock::now() + chrono::milliseconds(FlushMillis);
+		    }
+		    if( idle && !last ) this_thread::sleep_for(chrono::milliseconds(1));
+		}
+	    }
+
+	    // Moves queued records into the per-file buffers. False if there were none.
+	    bool drain() {
+		Record record;
+		bool any = false;
+		while( queue.pop(record) ) {
+		    any = true;
+		    Pending& file = pending[record.fileName];
+		    if( record.append ) {
+			file.text += record.text;
+		    } else {
+			file.replace = true;	// Whatever came before is overwritten
+			file.text.swap(record.text);
+		    }
+		}
+		return any;
+	    }
+
+	    void writeFiles() {
+		for( map<string, Pending>::iterator it=pending.begin(); it!=pending.end(); ++it ) {
+		    ofstream out(it->first.c_str(), it->second.replace ? ios::trunc : ios::app);
+		    out << it->second.text;
+		}
+		pending.clear();
+	    }
+
+	    Queue queue;
+	    map<string, Pending> pending;	// Background thread only
+	    thread worker;
+	    atomic<bool> stopping;
+	    atomic<long> flushRequests, flushesDone;
+	    atomic<long> dropped;
+	};
+
+	atomic<Sink*> theSink(0);
+
+	Sink& sink() {
+	    Sink* current = theSink.load(memory_order_acquire);
+	    if( !current ) {
+		Sink* fresh = new Sink;
+		if( theSink.compare_exchange_strong(current, fresh) ) current = fresh;
+		else delete fresh;	// Another thread's came first
+	    }
+	    return *current;
+	}
+
+	/*
+	 * A child of fork() has none of the parent's threads, so the sink it
+	 * inherits would never be drained. The child forgets it (the parent
+	 * writes what was queued) and makes its own on first use.
+	 */
+	void forgetSinkInChild() {
+	    theSink.store(0, memory_order_relaxed);
+	}
+
+	struct SinkOwner {
+	    SinkOwner() { pthread_atfork(0, 0, forgetSinkInChild); }
+	    ~SinkOwner() { delete theSink.load(); }
+	} sinkOwner;
+    }
+
+    void write( const char* fileName, const string& text ) {
+	sink().add(fileName, false, text);
+    }
+
+    void append( const char* fileName, const string& text ) {
+	sink().add(fileName, true, text);
+    }
+
+    void flush() {
+	Sink* current = theSink.load(memory_order_acquire);
+	if( current ) current->flush();	// Nothing was ever queued otherwise
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * Diagnostics.h: asynchronous diagnostic files for players.
+ * Date:          October 2026
+ *
+ * Players that dump heat maps or board snapshots hand the text to
+ * Diagnostics::write() (replace the file) or Diagnostics::append() and carry
+ * on. The text goes into a lock-free queue; a background thread empties it
+ * and writes the files out every FlushMillis, so a file that is rewritten
+ * every round is written once per flush, and appends are batched. Pending
+ * output is flushed when the program exits normally.
+ *
+ * A child made with fork() starts with nothing pending and its own writer
+ * thread; what the parent had queued is the parent's to write. A child that
+ * leaves with _exit() must flush() first.
+ *
+ * The queue never blocks a player: if it stays full for a few yields the
+ * record is dropped (and counted at exit). Build with -DNO_DIAGNOSTICS to compile all of it out; check
+ * Diagnostics::Enabled before building the text so that goes too:
+ *
+ *   if( Diagnostics::Enabled ) {
+ *       ostringstream text;
+ *       ...
+ *       Diagnostics::write("heatMap.txt", text.str());
+ *   }
+ */
+
+#ifndef DIAGNOSTICS_H		// Double inclusion protection
+#define DIAGNOSTICS_H
+
+#include <string>
+
+using namespace std;
+
+namespace Diagnostics {
+#ifdef NO_DIAGNOSTICS
+    const bool Enabled = false;
+
+    inline void write( const char*, const string& ) {}
+    inline void append( const char*, const string& ) {}
+    inline void flush() {}
+#else
+    const bool Enabled = true;
+
+    const int FlushMillis = 200;	// How often the files are written
+    const int QueueSize = 16384;	// Records waiting at most (a power of 2)
+
+    /**
+     * @brief Replaces the contents of fileName with text (at the next flush).
+     * @param fileName Must stay valid for the life of the program, e.g. a literal.
+     */
+    void write( const char* fileName, const string& text );
+
+    /**
+     * @brief Adds text to the end of fileName (at the next flush).
+     */
+    void append( const char* fileName, const string& text );
+
+    /**
+     * @brief Writes everything queued so far before returning.
+     */
+    void flush();
+#endif
+}
+
+#endif
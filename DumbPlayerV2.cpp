@@ -27,7 +27,7 @@
  * before rounds; newRound() gets called before every round.
  */
 DumbPlayerV2::DumbPlayerV2( int boardSize )
-    :PlayerV2(boardSize)
+    :PlayerV2(boardSize), board(boardSize)
 {
     // Could do any initialization of inter-round data structures here.
 }
@@ -40,7 +40,7 @@ DumbPlayerV2::DumbPlayerV2( int boardSize )
 DumbPlayerV2::~DumbPlayerV2( ) {}
 
 /*
- * Private internal function that initializes a MAX_BOARD_SIZE 2D array of char to water.
+ * Private internal function that initializes the board to water.
  */
 void DumbPlayerV2::initializeBoard() {
     for(int row=0; row<boardSize; row++) {
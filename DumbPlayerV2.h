@@ -13,6 +13,7 @@ using namespace std;
 
 #include "PlayerV2.h"
 #include "Message.h"
+#include "Grid.h"
 #include "defines.h"
 
 // DumbPlayer inherits from/extends PlayerV2
@@ -31,7 +32,7 @@ class DumbPlayerV2: public PlayerV2 {
         int lastRow;
         int lastCol;
 	int numShipsPlaced;
-        char board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+        Grid<char> board;
 };
 
 #endif
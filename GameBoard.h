@@ -0,0 +1,44 @@
+/**
+ * GameBoard.h: what AIContest needs from a board.
+ * Date:        October 2026
+ *
+ * BoardV3 works for board sizes up to 10. Board<N> (Board.h) is the same
+ * board with the size fixed at compile time, and LargeBoard takes any size
+ * up to MAX_LARGE_BOARD_SIZE. AIContest holds its boards as GameBoards and
+ * gets them from a BoardFactory, which the programs choose once for the
+ * tournament's board size with boardFactory().
+ */
+
+#ifndef GAMEBOARD_H		// Double inclusion protection
+#define GAMEBOARD_H
+
+#include "defines.h"
+#include "Bitboard.h"
+
+class GameBoard {
+    public:
+	virtual ~GameBoard() {}
+
+	virtual bool placeShip(int row, int col, int length, Direction dir) = 0;
+	virtual char getOpponentView(int row, int col) = 0;
+	virtual char getOwnerView(int row, int col) = 0;
+	virtual char getShipMark(int row, int col) = 0;
+	virtual ShipLocation getShip(int row, int col) = 0;	// Length 0 for water
+	virtual Bitboard getShipCells(int row, int col) = 0;	// Empty if the board is too big for a Bitboard
+	virtual char processShot(int row, int col) = 0;
+	virtual bool hasWon() = 0;
+	virtual void clear() = 0;	// Empty again, as made; no allocation
+};
+
+/**
+ * @brief Makes an empty board of the given size.
+ */
+typedef GameBoard* (*BoardFactory)( int boardSize );
+
+/**
+ * @brief The factory of the fastest board for boardSize: Board<boardSize>
+ * for 3 to 10, LargeBoard above that. Defined in Board.cpp.
+ */
+BoardFactory boardFactory( int boardSize );
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * GameLog.cpp: compact binary log of AIContest games, and its reader.
+ * Date:        October 2026
+ */
+
+#include <cstring>
+
+#include "GameLog.h"
+
+using namespace std;
+
+namespace {
+    const char Magic[4] = { 'B', 'S', 'G', 'L' };
+    const unsigned char Version = 2;
+    const int HeaderSize = 8;
+
+    enum Flags { HaveGameId = 1, Player1Won = 2, Player2Won = 4 };
+
+    // Largest encoding of a game: fixed fields, names of up to 255 bytes, placements, shots.
+    size_t maxRecordSize( const GameRecord& record ) {
+	return 1+16+3+record.numShips + 2*(3+255+5*record.numShips) + 8 + 3*record.numShots;
+    }
+
+    unsigned char* put( unsigned char* out, uint64_t value, int bytes ) {
+	for( int i=0; i<bytes; i++ ) {
+	    *out++ = (unsigned char)(value >> (8*i));
+	}
+	return out;
+    }
+
+    /*
+     * Reads little endian integers from a buffer, remembering whether it
+     * ever ran past the end.
+     */
+    class Input {
+      public:
+	Input( const vector<unsigned char>& data, size_t pos ) : data(data), pos(pos), overrun(false) {}
+
+	uint64_t get( int bytes ) {
+	    if( pos + bytes > data.size() ) {
+		overrun = true;
+		pos = data.size();
+		return 0;
+	    }
+	    uint64_t value = 0;
+	    for( int i=0; i<bytes; i++ ) {
+		value |= uint64_t(data[pos++]) << (8*i);
+	    }
+	    return value;
+	}
+
+	string getString( size_t length ) {
+	    if( pos + length > data.size() ) {
+		overrun = true;
+		pos = data.size();
+		return "";
+	    }
+	    string result((const char*)&data[pos], length);
+	    pos += length;
+	    return result;
+	}
+
+	const vector<unsigned char>& data;
+	size_t pos;
+	bool overrun;
+    };
+}
+
+void GameRecord::begin( int boardSize, int numShips, const int shipLengths[] ) {
+    this->boardSize = boardSize;
+    this->numShips = numShips;
+    this->shipLengths.assign(shipLengths, shipLengths+numShips);
+    placements[0].resize(numShips);
+    placements[1].resize(numShips);
+    shotCells.resize(4*boardSize*boardSize);
+    shotResults.resize(4*boardSize*boardSize);
+    haveGameId = false;
+    game.seed = 0;
+    game.pairing = 0;
+    game.round = 0;
+    shipsPlaced[0] = shipsPlaced[1] = 0;
+    playerWon[0] = playerWon[1] = false;
+    totalMoves = 0;
+    numShots = 0;
+}
+
+void GameRecord::addPlacement( int player, int row, int col, Direction dir ) {
+    if( shipsPlaced[player] == numShips ) return;
+    // Anything beyond a short is off the board anyway.
+    ShipPlacement& placement = placements[player][shipsPlaced[player]++];
+    placement.row = row >= -1 && row <= 0x7fff ? row : -1;
+    placement.col = col >= -1 && col <= 0x7fff ? col : -1;
+    placement.dir = dir;
+}
+
+GameLogWriter::GameLogWriter() {
+    file = 0;
+    used = 0;
+}
+
+GameLogWriter::~GameLogWriter() {
+    if( file ) {
+	flushBuffer();
+	fclose(file);
+    }
+}
+
+bool GameLogWriter::open( const string& fileName ) {
+    lock_guard<mutex> guard(lock);
+    if( file ) {
+	flushBuffer();
+	fclose(file);
+    }
+    file = fopen(fileName.c_str(), "wb");
+    if( !file ) return false;
+    buffer.resize(BufferSize);
+    memcpy(&buffer[0], Magic, 4);
+    buffer[4] = Version;
+    buffer[5] = buffer[6] = buffer[7] = 0;
+    used = HeaderSize;
+    return true;
+}
+
+void GameLogWriter::write( const GameRecord& record ) {
+    lock_guard<mutex> guard(lock);
+    if( !file ) return;
+    size_t size = maxRecordSize(record);
+    if( used + size > buffer.size() ) flushBuffer();
+    if( size > buffer.size() ) buffer.resize(size);	// A huge board
+
+    unsigned char* out = &buffer[used];
+    int flags = (record.haveGameId ? HaveGameId : 0) | (record.playerWon[0] ? Player1Won : 0)
+		| (record.playerWon[1] ? Player2Won : 0);
+    out = put(out, flags, 1);
+    out = put(out, record.game.seed, 8);
+    out = put(out, uint32_t(record.game.pairing), 4);
+    out = put(out, uint32_t(record.game.round), 4);
+    out = put(out, record.boardSize, 1);
+    out = put(out, record.numShips, 2);
+    for( int i=0; i<record.numShips; i++ ) {
+	out = put(out, record.shipLengths[i], 1);
+    }
+    for( int player=0; player<2; player++ ) {
+	const string& name = record.playerNames[player];
+	size_t length = name.size() < 255 ? name.size() : 255;
+	out = put(out, length, 1);
+	memcpy(out, name.data(), length);
+	out += length;
+	out = put(out, record.shipsPlaced[player], 2);
+	for( int i=0; i<record.shipsPlaced[player]; i++ ) {
+	    const ShipPlacement& placement = record.placements[player][i];
+	    out = put(out, uint16_t(placement.row), 2);
+	    out = put(out, uint16_t(placement.col), 2);
+	    out = put(out, placement.dir, 1);
+	}
+    }
+    out = put(out, uint32_t(record.totalMoves), 4);
+    out = put(out, uint32_t(record.numShots), 4);
+    for( int i=0; i<record.numShots; i++ ) {
+	out = put(out, record.shotCells[i], 2);
+	out = put(out, (unsigned char)record.shotResults[i], 1);
+    }
+    used = out - &buffer[0];
+}
+
+void GameLogWriter::flush() {
+    lock_guard<mutex> guard(lock);
+    if( file ) {
+	flushBuffer();
+	fflush(file);
+    }
+}
+
+// Caller holds the lock.
+void GameLogWriter::flushBuffer() {
+    if( used > 0 ) {
+	fwrite(&buffer[0], 1, used, file);
+	used = 0;
+    }
+}
+
+GameLogReader::GameLogReader() {
+    pos = 0;
+    version = Version;
+}
+
+bool GameLogReader::open( const string& fileName ) {
+    data.clear();
+    pos = 0;
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if( !file ) {
+	problem = "can't open " + fileName;
+	return false;
+    }
+    unsigned char chunk[65536];
+    size_t count;
+    while( (count = fread(chunk, 1, sizeof(chunk), file)) > 0 ) {
+	data.insert(data.end(), chunk, chunk+count);
+    }
+    fclose(file);
+
+    if( data.size() < (size_t)HeaderSize || memcmp(&data[0], Magic, 4) != 0 ) {
+	problem = fileName + " is not a game log";
+	return false;
+    }
+    if( data[4] < 1 || data[4] > Version ) {
+	problem = fileName + " is a version " + to_string(data[4]) + " game log, expected "
+		  + to_string(Version);
+	return false;
+    }
+    version = data[4];
+    pos = HeaderSize;
+    problem = "";
+    return true;
+}
+
+bool GameLogReader::next( GameRecord& record ) {
+    if( pos >= data.size() ) return false;
+
+    Input in(data, pos);
+    int flags = in.get(1);
+    GameId game;
+    game.seed = in.get(8);
+    game.pairing = int32_t(in.get(4));
+    game.round = int32_t(in.get(4));
+    int countBytes = version == 1 ? 1 : 2;
+    int boardSize = in.get(1);
+    int numShips = in.get(countBytes);
+    vector<int> shipLengths(numShips);
+    bool ok = boardSize > 0 && boardSize <= MAX_LARGE_BOARD_SIZE;
+    for( int i=0; ok && i<numShips; i++ ) {
+	shipLengths[i] = in.get(1);
+    }
+    if( ok ) {
+	record.begin(boardSize, numShips, numShips > 0 ? &shipLengths[0] : 0);
+	record.haveGameId = flags & HaveGameId;
+	record.game = game;
+	record.playerWon[0] = flags & Player1Won;
+	record.playerWon[1] = flags & Player2Won;
+    }
+    for( int player=0; ok && player<2; player++ ) {
+	record.playerNames[player] = in.getString(in.get(1));
+	int placed = in.get(countBytes);
+	ok = placed <= numShips;
+	for( int i=0; ok && i<placed; i++ ) {
+	    int row = int16_t(in.get(2));
+	    int col = int16_t(in.get(2));
+	    record.addPlacement(player, row, col, Direction(in.get(1)));
+	}
+    }
+    if( ok ) {
+	record.totalMoves = in.get(4);
+	uint32_t numShots = in.get(4);
+	ok = numShots <= (uint32_t)record.maxShots();
+	for( uint32_t i=0; ok && i<numShots; i++ ) {
+	    record.shotCells[i] = in.get(2);
+	    record.shotResults[i] = char(in.get(1));
+	}
+	record.numShots = ok ? numShots : 0;
+    }
+    if( !ok || in.overrun ) {
+	problem = "damaged game record at byte " + to_string(pos);
+	pos = data.size();
+	return false;
+    }
+    pos = in.pos;
+    return true;
+}
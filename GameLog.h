@@ -0,0 +1,153 @@
+/**
+ * GameLog.h: compact binary log of AIContest games, and its reader.
+ * Date:      October 2026
+ *
+ * AIContest fills in a GameRecord as it plays (fleet, both players'
+ * placements, every shot with its result) and hands it to a GameLogWriter,
+ * which encodes it into a large buffer and writes the buffer out when it
+ * fills. The replay tool reads the file back with GameLogReader.
+ *
+ * File layout (integers little endian):
+ *
+ *   "BSGL" version(1) 0 0 0
+ *   then per game:
+ *     flags(1)                 HaveGameId | Player1Won | Player2Won
+ *     seed(8) pairing(4) round(4)
+ *     boardSize(1) numShips(2) shipLength(1) x numShips
+ *     per player: nameLength(1) name, shipsPlaced(2),
+ *                 shipsPlaced x [row(2) col(2) direction(1)]
+ *     totalMoves(4) numShots(4)
+ *     numShots x [cell(2) result(1)]
+ *
+ * Shots alternate player 1, player 2, as AIContest::play() takes them. A
+ * cell is row*boardSize+col, or OffBoard for coordinates outside the board.
+ * A player's placements stop at the first one the board refused. Version 1
+ * logs (boards up to 10x10) had one byte counts of ships; they still read.
+ * Several threads may write to one log; games land in the order they end.
+ */
+
+#ifndef GAMELOG_H		// Double inclusion protection
+#define GAMELOG_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include "defines.h"
+#include "Random.h"
+
+using namespace std;
+
+struct ShipPlacement {
+    int row;
+    int col;
+    Direction dir;
+};
+
+/**
+ * @brief Everything needed to play one game again.
+ */
+struct GameRecord {
+    static const int OffBoard = 0xffff;
+
+    /**
+     * @brief Starts a new game; forgets placements and shots. Sizes the
+     * arrays for the board (AIContest::play() shoots at most 4*boardSize^2 times).
+     */
+    void begin( int boardSize, int numShips, const int shipLengths[] );
+
+    int maxShots() const { return shotCells.size(); }
+
+    void addPlacement( int player, int row, int col, Direction dir );
+    void addShot( int row, int col, char result ) {
+	if( numShots == maxShots() ) return;
+	bool onBoard = row >= 0 && row < boardSize && col >= 0 && col < boardSize;
+	shotCells[numShots] = onBoard ? row*boardSize + col : OffBoard;
+	shotResults[numShots] = result;
+	numShots++;
+    }
+
+    // Shot i was taken by player i%2 (0 = player 1).
+    int shotRow( int i ) const { return shotCells[i] == OffBoard ? -1 : shotCells[i] / boardSize; }
+    int shotCol( int i ) const { return shotCells[i] == OffBoard ? -1 : shotCells[i] % boardSize; }
+
+    bool haveGameId;
+    GameId game;
+    int boardSize;
+    int numShips;
+    vector<int> shipLengths;
+    string playerNames[2];
+    int shipsPlaced[2];
+    vector<ShipPlacement> placements[2];
+    bool playerWon[2];
+    int totalMoves;
+    int numShots;
+    vector<uint16_t> shotCells;
+    vector<char> shotResults;
+};
+
+/**
+ * @brief Appends encoded games to a log file. Safe to share between threads.
+ */
+class GameLogWriter {
+  public:
+    GameLogWriter();
+    ~GameLogWriter();	// Flushes and closes
+
+    /**
+     * @brief Creates (or truncates) the file and writes the file header.
+     * @return false if the file can't be created.
+     */
+    bool open( const string& fileName );
+
+    void write( const GameRecord& record );
+
+    /**
+     * @brief Writes out whatever is buffered.
+     */
+    void flush();
+
+    static const int BufferSize = 1 << 20;
+
+  private:
+    GameLogWriter( const GameLogWriter& );
+    void operator=( const GameLogWriter& );
+    void flushBuffer();
+
+    FILE* file;
+    vector<unsigned char> buffer;
+    size_t used;
+    mutex lock;
+};
+
+/**
+ * @brief Reads the games of a log file in order.
+ */
+class GameLogReader {
+  public:
+    GameLogReader();
+
+    /**
+     * @brief Reads the whole file into memory and checks its header.
+     * @return false (with error() saying why) if it isn't a game log.
+     */
+    bool open( const string& fileName );
+
+    /**
+     * @brief Decodes the next game.
+     * @return false at the end of the log, or if the rest is damaged (see error()).
+     */
+    bool next( GameRecord& record );
+
+    const string& error() const { return problem; }
+
+  private:
+    vector<unsigned char> data;
+    size_t pos;
+    int version;	// Of the file being read
+    string problem;
+};
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * Grid.h: per-cell state for boards of any size.
+ * Date:   October 2026
+ *
+ * Grid<T> is a boardSize x boardSize array in one row-major block, allocated
+ * once. grid[row][col] works as it does for the fixed
+ * [MAX_BOARD_SIZE][MAX_BOARD_SIZE] arrays it replaces. CellSet is one bit
+ * per cell (row*boardSize + col), packed into 64-bit words, for yes/no
+ * state on boards too large for a Bitboard. OrderedCellSet also finds its
+ * k-th cell in row-major order in O(log cells), for players that pick a
+ * random cell out of a set that shrinks as they shoot.
+ */
+
+#ifndef GRID_H		// Double inclusion protection
+#define GRID_H
+
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+template <class T>
+class Grid {
+    public:
+	Grid( int size, const T& value = T() ) : size(size), cells(new T[size*size]) {
+	    fill(value);
+	}
+	~Grid() { delete[] cells; }
+
+	T* operator[]( int row ) { return cells + row*size; }
+	const T* operator[]( int row ) const { return cells + row*size; }
+
+	void fill( const T& value ) {
+	    for( int i=0; i<size*size; i++ ) cells[i] = value;
+	}
+
+    private:
+	Grid( const Grid& );		// Players own their grids; no copies
+	void operator=( const Grid& );
+
+	int size;
+	T* cells;
+};
+
+class CellSet {
+    public:
+	CellSet( int numCells = 0 ) : words((numCells+63)/64, 0) {}
+
+	bool test( int cell ) const { return (words[cell >> 6] >> (cell & 63)) & 1; }
+	void set( int cell ) { words[cell >> 6] |= uint64_t(1) << (cell & 63); }
+	void reset( int cell ) { words[cell >> 6] &= ~(uint64_t(1) << (cell & 63)); }
+
+	void clear() {
+	    for( size_t i=0; i<words.size(); i++ ) words[i] = 0;
+	}
+
+	// The lowest cell in the set (row-major order), or -1 if it is empty.
+	int first() const {
+	    for( size_t i=0; i<words.size(); i++ ) {
+		if( words[i] ) return i*64 + __builtin_ctzll(words[i]);
+	    }
+	    return -1;
+	}
+
+	int count() const {
+	    int total = 0;
+	    for( size_t i=0; i<words.size(); i++ ) total += __builtin_popcountll(words[i]);
+	    return total;
+	}
+
+    private:
+	vector<uint64_t> words;
+};
+
+/**
+ * @brief A set of cells that keeps its size and can find its k-th cell.
+ * A Fenwick tree over the cells counts the members up to each cell.
+ */
+class OrderedCellSet {
+    public:
+	OrderedCellSet( int numCells ) : numCells(numCells), member(new bool[numCells]), tree(new int[numCells+1]) {
+	    for( top=1; top*2 <= numCells; top*=2 ) {}
+	    clear();
+	}
+	~OrderedCellSet() {
+	    delete[] member;
+	    delete[] tree;
+	}
+
+	bool test( int cell ) const { return member[cell]; }
+	int size() const { return total; }
+
+	void insert( int cell ) {
+	    if( member[cell] ) return;
+	    member[cell] = true;
+	    total++;
+	    for( int i=cell+1; i<=numCells; i += i & -i ) tree[i]++;
+	}
+
+	void erase( int cell ) {
+	    if( !member[cell] ) return;
+	    member[cell] = false;
+	    total--;
+	    for( int i=cell+1; i<=numCells; i += i & -i ) tree[i]--;
+	}
+
+	void clear() {
+	    for( int i=0; i<numCells; i++ ) member[i] = false;
+	    for( int i=0; i<=numCells; i++ ) tree[i] = 0;
+	    total = 0;
+	}
+
+	/**
+	 * @brief The k-th member (from 0) in cell order, or -1 if k >= size().
+	 */
+	int select( int k ) const {
+	    if( k < 0 || k >= total ) return -1;
+	    int cell = 0;	// Members in cells [0, cell) are <= k
+	    for( int step=top; step>0; step/=2 ) {
+		if( cell+step <= numCells && tree[cell+step] <= k ) {
+		    cell += step;
+		    k -= tree[cell];
+		}
+	    }
+	    return cell;
+	}
+
+    private:
+	OrderedCellSet( const OrderedCellSet& );
+	void operator=( const OrderedCellSet& );
+
+	int numCells;
+	bool* member;
+	int* tree;		// tree[i]: members in cells (i - (i & -i), i]
+	int total;
+	int top;		// Largest power of 2 <= numCells
+};
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * HuntTarget.cpp: hunt/target shooting for players.
+ * Date:           October 2026
+ */
+
+#include <algorithm>
+
+#include "HuntTarget.h"
+
+namespace {
+    // Shot labels, interned the first time they are used.
+    enum ShotLabel { ScanShooting, RunOut, TargetShooting, MaxShooting, DensityShooting, NumShotLabels };
+
+    int shotLabel( ShotLabel which ) {
+	static const int ids[NumShotLabels] = {
+	    MessageLabels::intern("Scan Shooting"), MessageLabels::intern("RUNOUT"),
+	    MessageLabels::intern("Target Shooting"), MessageLabels::intern("Max Shooting"),
+	    MessageLabels::intern("Density Shooting")
+	};
+	return ids[which];
+    }
+
+    // Steps of up, right, down, left.
+    const int RowStep[4] = { -1, 0, 1, 0 };
+    const int ColStep[4] = { 0, 1, 0, -1 };
+}
+
+HuntTarget::HuntTarget( int boardSize, HuntPolicy& policy )
+    : boardSize(boardSize), policy(policy), shots(boardSize*boardSize), open(boardSize*boardSize), source(-1)
+{
+}
+
+void HuntTarget::newRound() {
+    shots.clear();
+    open.clear();
+    source = -1;
+    policy.newRound();
+}
+
+void HuntTarget::mark( int cell, char result ) {
+    shots.set(cell);
+    if( result == HIT ) open.set(cell);
+    else open.reset(cell);
+    policy.shot(cell, result);
+}
+
+void HuntTarget::update( PackedMessage msg ) {
+    switch( msg.getMessageType() ) {
+	case MISS:
+	case HIT:
+	case KILL:
+	    mark(msg.getRow()*boardSize + msg.getCol(), msg.getMessageType());
+	    break;
+	default:
+	    break;
+    }
+}
+
+void HuntTarget::sunk( const ShipKill& kill ) {
+    mark(kill.row*boardSize + kill.col, HIT);
+    for( int i=0; i<kill.length(); i++ ) {
+	mark(kill.cellRow(i)*boardSize + kill.cellCol(i), KILL);
+    }
+    policy.sunk(kill);
+}
+
+PackedMessage HuntTarget::nextShot( Random& rng ) {
+    if( source != -1 && !open.test(source) ) source = -1;	// Sunk since
+    if( source == -1 ) source = open.first();
+
+    int cell = source == -1 ? -1 : followUp(source / boardSize, source % boardSize);
+    int label = shotLabel(TargetShooting);
+    if( cell == -1 ) {
+	cell = policy.pick(rng);
+	label = policy.label();
+    }
+    if( cell == -1 ) {
+	return PackedMessage( SHOT, 0, 0, None, 1, shotLabel(RunOut) );
+    }
+    return PackedMessage( SHOT, cell / boardSize, cell % boardSize, None, 1, label );
+}
+
+/*
+ * The water cell that continues the hits through (row, col), or -1 if
+ * every direction is closed (which a legal fleet never leaves).
+ */
+int HuntTarget::followUp( int row, int col ) const {
+    searchDirection dir = up;
+    bool directionsValidity[4] = { true, true, true, true };
+    int directionsLeft = 4;
+    int currRow = row;
+    int currCol = col;
+    while( directionsLeft > 0 ) {
+	if( !directionsValidity[dir] ) {
+	    dir = searchDirection((dir+1) % 4);		// The adjacent direction
+	    continue;
+	}
+	int nextRow = currRow + RowStep[dir];
+	int nextCol = currCol + ColStep[dir];
+	if( isWater(nextRow, nextCol) ) {
+	    return nextRow*boardSize + nextCol;
+	}
+	if( isHit(nextRow, nextCol) ) {		// Same ship, probably: keep going
+	    currRow = nextRow;
+	    currCol = nextCol;
+	    continue;
+	}
+	// The ship can't go on this way. Past the source, it must go the other way.
+	directionsValidity[dir] = false;
+	directionsLeft--;
+	if( currRow == row && currCol == col ) {
+	    dir = searchDirection((dir+1) % 4);
+	} else {
+	    dir = searchDirection((dir+2) % 4);
+	    currRow = row;
+	    currCol = col;
+	}
+    }
+    return -1;
+}
+
+ParityHunt::ParityHunt( int boardSize )
+    : boardSize(boardSize), cells(boardSize*boardSize)
+{
+}
+
+/**
+ * @brief Every third cell of each row, starting one column later on each
+ * row (1, 2, 0, 1, 2, ...), so the cells form diagonals three apart.
+ */
+void ParityHunt::newRound() {
+    cells.clear();
+    int startCol = 1;
+    for( int row=0; row<boardSize; row++ ) {
+	for( int col=startCol; col<boardSize; col+=3 ) {
+	    cells.insert(row*boardSize + col);
+	}
+	startCol = (startCol+1) % 3;
+    }
+}
+
+int ParityHunt::pick( Random& rng ) {
+    return cells.select(rng.below(cells.size()));	// In row-major order
+}
+
+int ParityHunt::label() const {
+    return shotLabel(ScanShooting);
+}
+
+HeatMapHunt::HeatMapHunt( int boardSize, int warmupRounds )
+    : ParityHunt(boardSize), warmupRounds(warmupRounds), rounds(0), heatMap(boardSize, 0), next(0)
+{
+    order.reserve(boardSize*boardSize);
+}
+
+/**
+ * @brief Orders the lattice by heat. A cell only gets hotter when it is
+ * hit, and then it has left the lattice, so the order holds for the round.
+ */
+void HeatMapHunt::newRound() {
+    ParityHunt::newRound();
+    rounds++;
+    order.clear();
+    next = 0;
+    if( !warm() ) return;
+    for( int cell=0; cell<boardSize*boardSize; cell++ ) {
+	if( cells.test(cell) ) order.push_back(cell);
+    }
+    const Grid<int>& heat = heatMap;
+    int size = boardSize;
+    sort(order.begin(), order.end(), [&heat, size]( int a, int b ) {
+	int heatA = heat[a / size][a % size];
+	int heatB = heat[b / size][b % size];
+	return heatA != heatB ? heatA > heatB : a < b;
+    });
+}
+
+void HeatMapHunt::warmStart( const int heat[], int rounds ) {
+    for( int cell=0; cell<boardSize*boardSize; cell++ ) {
+	heatMap[cell / boardSize][cell % boardSize] += heat[cell];
+    }
+    this->rounds += rounds;
+}
+
+void HeatMapHunt::shot( int cell, char result ) {
+    if( result == HIT ) heatMap[cell / boardSize][cell % boardSize]++;
+    ParityHunt::shot(cell, result);
+}
+
+int HeatMapHunt::pick( Random& rng ) {
+    if( !warm() ) return ParityHunt::pick(rng);
+    while( next < order.size() && !cells.test(order[next]) ) next++;	// Shot since
+    return next < order.size() ? order[next] : -1;
+}
+
+int HeatMapHunt::label() const {
+    return warm() ? shotLabel(MaxShooting) : shotLabel(ScanShooting);
+}
+
+DensityHunt::DensityHunt( int boardSize )
+    : boardSize(boardSize), targeter(boardSize)
+{
+}
+
+void DensityHunt::shot( int cell, char result ) {
+    if( result == MISS ) targeter.miss(cell / boardSize, cell % boardSize);
+    else if( result == HIT ) targeter.hit(cell / boardSize, cell % boardSize);
+}
+
+int DensityHunt::label() const {
+    return shotLabel(DensityShooting);
+}
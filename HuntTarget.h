@@ -0,0 +1,176 @@
+/**
+ * HuntTarget.h: hunt/target shooting for players: finish off the ships
+ *               already hit, otherwise shoot where a hunt policy says.
+ * Date:         October 2026
+ *
+ * HuntTarget keeps what a player knows of the opponent's board as two
+ * CellSets: the cells shot at, and the hits on ships not sunk yet. While
+ * there is such an open hit, the next shot follows it up the way Deng always
+ * did: from the source hit, walk up, right, down, left past further hits
+ * and shoot the first water cell; a direction that ends in a miss, a sunk
+ * ship or the edge is given up, turning to the opposite direction once the
+ * walk has left the source and to the next one before. The source stays the
+ * same until it is sunk; the next source is the first open hit in row-major
+ * order. A follow-up costs a few bit tests per cell of the ship being
+ * walked, whatever the board size.
+ *
+ * With no open hit the HuntPolicy picks the shot. Policies see every
+ * result, so they can learn across rounds:
+ *
+ *   ParityHunt    a random cell of a lattice covering every third cell
+ *                 along each row and column, so no ship of 3 or more fits
+ *                 between its cells,
+ *   HeatMapHunt   the lattice at random for the first rounds, then the
+ *                 lattice cell where it has hit ships most often,
+ *   DensityHunt   the cell most placements of the ships still afloat cover
+ *                 (DensityTargeter; boards of up to Bitboard::Capacity cells).
+ */
+
+#ifndef HUNTTARGET_H		// Double inclusion protection
+#define HUNTTARGET_H
+
+#include <vector>
+
+#include "PackedMessage.h"
+#include "DensityTargeter.h"
+#include "Random.h"
+#include "Grid.h"
+#include "defines.h"
+
+using namespace std;
+
+class HuntPolicy {
+    public:
+	virtual ~HuntPolicy() {}
+
+	virtual void newRound() {}
+	virtual void addShip( int length ) {}
+
+	/**
+	 * @brief One cell's result, cell = row*boardSize + col: MISS, HIT or KILL.
+	 * A sunk ship is a HIT for the shot that sank it, then a KILL per cell.
+	 */
+	virtual void shot( int cell, char result ) {}
+
+	/**
+	 * @brief A sunk ship as a whole, after its shot() calls (packed players only).
+	 */
+	virtual void sunk( const ShipKill& kill ) {}
+
+	/**
+	 * @brief The next hunting shot, row*boardSize + col; -1 if there is none.
+	 */
+	virtual int pick( Random& rng ) = 0;
+
+	/**
+	 * @brief MessageLabels id for the shots pick() chooses now.
+	 */
+	virtual int label() const = 0;
+};
+
+class HuntTarget {
+    public:
+	/**
+	 * @param policy Hunts when there is no hit to follow up; not owned.
+	 */
+	HuntTarget( int boardSize, HuntPolicy& policy );
+
+	/**
+	 * @brief Forgets the board; the policy starts a round too.
+	 */
+	void newRound();
+
+	void addShip( int length ) { policy.addShip(length); }
+
+	/**
+	 * @brief Takes MISS, HIT and KILL results of our shots; ignores other messages.
+	 */
+	void update( PackedMessage msg );
+
+	void sunk( const ShipKill& kill );
+
+	/**
+	 * @brief The follow-up of the open hits if there is one, else the policy's
+	 * shot; (0, 0) labelled RUNOUT if neither has a cell left.
+	 */
+	PackedMessage nextShot( Random& rng );
+
+	bool isWater( int row, int col ) const { return isValid(row, col) && !shots.test(row*boardSize + col); }
+	bool isHit( int row, int col ) const { return isValid(row, col) && open.test(row*boardSize + col); }
+
+    private:
+	enum searchDirection { up=0, right=1, down=2, left=3 };
+
+	bool isValid( int row, int col ) const { return row>=0 && row<boardSize && col>=0 && col<boardSize; }
+	void mark( int cell, char result );
+	int followUp( int row, int col ) const;
+
+	int boardSize;
+	HuntPolicy& policy;
+	CellSet shots;		// Every cell shot at
+	CellSet open;		// Hits on ships that are not sunk yet
+	int source;		// The open hit being followed up; -1 = none
+};
+
+class ParityHunt: public HuntPolicy {
+    public:
+	ParityHunt( int boardSize );
+
+	void newRound() override;
+	void shot( int cell, char result ) override { cells.erase(cell); }
+	int pick( Random& rng ) override;
+	int label() const override;
+
+    protected:
+	int boardSize;
+	OrderedCellSet cells;	// Lattice cells not shot yet
+};
+
+class HeatMapHunt: public ParityHunt {
+    public:
+	/**
+	 * @param warmupRounds Rounds to hunt at random (and learn) first.
+	 */
+	HeatMapHunt( int boardSize, int warmupRounds );
+
+	void newRound() override;
+	void shot( int cell, char result ) override;
+	int pick( Random& rng ) override;
+	int label() const override;
+
+	// Hits on ships at the cell, over every round.
+	int heat( int row, int col ) const { return heatMap[row][col]; }
+
+	/**
+	 * @brief Counts rounds learnt elsewhere (OpponentMemory) as if played here.
+	 * @param heat Hits by cell, row*boardSize+col.
+	 */
+	void warmStart( const int heat[], int rounds );
+
+    private:
+	bool warm() const { return rounds >= warmupRounds; }
+
+	int warmupRounds;
+	int rounds;
+	Grid<int> heatMap;
+	vector<int> order;	// Lattice cells, hottest first (row-major among equals)
+	size_t next;		// The first cell of order that may still be unshot
+};
+
+class DensityHunt: public HuntPolicy {
+    public:
+	DensityHunt( int boardSize );
+
+	void newRound() override { targeter.newRound(); }
+	void addShip( int length ) override { targeter.addShip(length); }
+	void shot( int cell, char result ) override;
+	void sunk( const ShipKill& kill ) override { targeter.sunk(kill.cells); }
+	int pick( Random& rng ) override { return targeter.bestCell(rng); }
+	int label() const override;
+
+    private:
+	int boardSize;
+	DensityTargeter targeter;
+};
+
+#endif
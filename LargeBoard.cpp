@@ -0,0 +1,126 @@
+/**
+ * LargeBoard.cpp: a board of any size up to MAX_LARGE_BOARD_SIZE.
+ * Date:           October 2026
+ */
+
+#include <iostream>
+
+#include "LargeBoard.h"
+
+using namespace std;
+
+LargeBoard::LargeBoard( int width )
+    : boardSize(width), occupied(width*width), shots(width*width), shipAt(width*width, -1)
+{
+    ships.reserve(width*width/MIN_SHIP_SIZE);
+    cellsLeft = 0;
+}
+
+/*
+ * Undoes the ships cell by cell, so clearing costs the fleet, not the board
+ * (apart from the shot bits).
+ */
+void LargeBoard::clear() {
+    for( size_t i=0; i<ships.size(); i++ ) {
+	const ShipLocation& ship = ships[i].location;
+	int step = ship.dir == Horizontal ? 1 : boardSize;
+	for( int n=0, cell=ship.row*boardSize + ship.col; n<ship.length; n++, cell+=step ) {
+	    occupied.reset(cell);
+	    shipAt[cell] = -1;
+	}
+    }
+    ships.clear();
+    shots.clear();
+    cellsLeft = 0;
+}
+
+bool LargeBoard::placeShip( int row, int col, int length, Direction dir ) {
+    bool horiz = dir==Horizontal;
+    if( !positionOk(row, col, length, horiz) ) return false;
+
+    Ship ship = { { row, col, length, horiz ? Horizontal : Vertical }, 0 };
+    int step = horiz ? 1 : boardSize;
+    for( int i=0, cell=row*boardSize + col; i<length; i++, cell+=step ) {
+	occupied.set(cell);
+	shipAt[cell] = ships.size();
+    }
+    ships.push_back(ship);
+    cellsLeft += length;
+    return true;
+}
+
+bool LargeBoard::positionOk( int row, int col, int length, bool horiz ) {
+    // Same checks and complaints as BoardV3.
+    if( (int)ships.size() >= boardSize*boardSize/MIN_SHIP_SIZE ) {
+	cerr << "positionOk: no room for another ship" << endl;
+	return false;
+    }
+    int end = (horiz ? col : row) + length-1;
+    if( !onBoard(row, col) || end >= boardSize ) {
+	cerr << "positionOk: " << (horiz ? "horizontal" : "vertical") << " position invalid" << endl;
+	return false;
+    }
+    int step = horiz ? 1 : boardSize;
+    for( int i=0, cell=row*boardSize + col; i<length; i++, cell+=step ) {
+	if( occupied.test(cell) ) {
+	    cerr << "positionOk: " << (horiz ? "horizontal" : "vertical") << " collision at row="
+		 << cell/boardSize << ", col=" << cell%boardSize << endl;
+	    return false;
+	}
+    }
+    return true;
+}
+
+char LargeBoard::getOpponentView( int row, int col ) {
+    int cell = row*boardSize + col;
+    if( !shots.test(cell) ) return WATER;
+    if( !occupied.test(cell) ) return MISS;
+    const Ship& ship = ships[shipAt[cell]];
+    return ship.hits == ship.location.length ? KILL : HIT;
+}
+
+char LargeBoard::getOwnerView( int row, int col ) {
+    int cell = row*boardSize + col;
+    if( occupied.test(cell) && !shots.test(cell) ) return getShipMark(row, col);
+    return getOpponentView(row, col);
+}
+
+char LargeBoard::getShipMark( int row, int col ) {
+    int ship = shipAt[row*boardSize + col];
+    return ship < 0 ? WATER : char('a' + ship);
+}
+
+ShipLocation LargeBoard::getShip( int row, int col ) {
+    if( !onBoard(row, col) || shipAt[row*boardSize + col] < 0 ) {
+	ShipLocation water = { row, col, 0, None };
+	return water;
+    }
+    return ships[shipAt[row*boardSize + col]].location;
+}
+
+Bitboard LargeBoard::getShipCells( int row, int col ) {
+    Bitboard cells;
+    ShipLocation ship = getShip(row, col);
+    if( boardSize*boardSize > Bitboard::Capacity ) return cells;
+    int step = ship.dir == Horizontal ? 1 : boardSize;
+    for( int i=0, cell=ship.row*boardSize + ship.col; i<ship.length; i++, cell+=step ) {
+	cells.set(cell);
+    }
+    return cells;
+}
+
+char LargeBoard::processShot( int row, int col ) {
+    if( !onBoard(row, col) ) return INVALID_SHOT;
+    int cell = row*boardSize + col;
+    if( shots.test(cell) ) return DUPLICATE_SHOT;
+    shots.set(cell);
+
+    if( shipAt[cell] < 0 ) return MISS;
+    Ship& ship = ships[shipAt[cell]];
+    cellsLeft--;
+    return ++ship.hits == ship.location.length ? KILL : HIT;
+}
+
+bool LargeBoard::hasWon() {
+    return cellsLeft == 0;
+}
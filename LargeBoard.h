@@ -0,0 +1,57 @@
+/**
+ * LargeBoard.h: a board of any size up to MAX_LARGE_BOARD_SIZE.
+ * Date:         October 2026
+ *
+ * Plays like BoardV3, but sized at run time: shots and ship cells are
+ * CellSets (one bit per cell), each cell knows its ship in a row-major
+ * array, and each ship keeps where it lies and how many of its cells are
+ * hit. A shot, the sunk check and the win check are O(1); a board takes a
+ * few bytes per cell, allocated once when it is made.
+ */
+
+#ifndef LARGEBOARD_H		// Double inclusion protection
+#define LARGEBOARD_H
+
+#include <vector>
+
+#include "GameBoard.h"
+#include "Grid.h"
+#include "defines.h"
+
+using namespace std;
+
+class LargeBoard: public GameBoard {
+    public:
+	LargeBoard( int width );
+	static GameBoard* create( int width ) { return new LargeBoard(width); }
+
+	bool placeShip(int row, int col, int length, Direction dir) override;
+	char getOpponentView(int row, int col) override;
+	char getOwnerView(int row, int col) override;
+	char getShipMark(int row, int col) override;
+	ShipLocation getShip(int row, int col) override;
+	Bitboard getShipCells(int row, int col) override;
+	char processShot(int row, int col) override;
+	bool hasWon() override;
+	void clear() override;
+
+    private:
+	struct Ship {
+	    ShipLocation location;
+	    int hits;
+	};
+
+	bool onBoard(int row, int col) const {
+	    return unsigned(row) < unsigned(boardSize) && unsigned(col) < unsigned(boardSize);
+	}
+	bool positionOk(int row, int col, int length, bool horiz);
+
+	int boardSize;
+	CellSet occupied;		// Cells covered by any ship
+	CellSet shots;			// Cells the opponent has fired at
+	vector<short> shipAt;		// Index into ships, -1 for water; row-major
+	vector<Ship> ships;		// In placement order
+	int cellsLeft;			// Ship cells not hit yet
+};
+
+#endif
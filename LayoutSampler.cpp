@@ -0,0 +1,188 @@
+/**
+ * LayoutSampler.cpp: random layouts of the opponent's fleet that fit the shots so far.
+ * Date:              October 2026
+ */
+
+#include "LayoutSampler.h"
+
+namespace {
+    // The mask moved k cells towards cell 0, 0 < k < 64.
+    Bitboard shiftDown( const Bitboard& cells, int k ) {
+	return Bitboard( (cells.lo >> k) | (cells.hi << (64-k)), cells.hi >> k );
+    }
+
+    // The index of the n-th (from 0) set cell of the mask; n < cells.count().
+    int nthCell( const Bitboard& cells, int n ) {
+	uint64_t word = cells.lo;
+	int base = 0;
+	int low = __builtin_popcountll(word);
+	if( n >= low ) {
+	    n -= low;
+	    word = cells.hi;
+	    base = 64;
+	}
+	for( int count; n >= (count = __builtin_popcountll(word & 0xff)); word >>= 8, base += 8 ) {
+	    n -= count;
+	}
+	for( ; n > 0; n-- ) word &= word - 1;
+	return base + __builtin_ctzll(word);
+    }
+}
+
+LayoutSampler::LayoutSampler( int boardSize ) {
+    this->boardSize = boardSize;
+
+    // The same placements, in the same order, as DensityTargeter.
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	for( int cell=0; cell<MaxCells; cell++ ) {
+	    throughCount[cell][length] = 0;
+	    startPlacement[length][Across][cell] = startPlacement[length][Down][cell] = -1;
+	}
+	placementCount[length] = 0;
+	if( length < MIN_SHIP_SIZE || length > boardSize ) continue;
+	for( int row=0; row<boardSize; row++ ) {
+	    for( int col=0; col+length<=boardSize; col++ ) {
+		Bitboard mask;
+		for( int i=0; i<length; i++ ) mask.set(row*boardSize + col+i);
+		startPlacement[length][Across][row*boardSize + col] = placementCount[length];
+		placements[length][placementCount[length]++] = mask;
+	    }
+	}
+	for( int row=0; row+length<=boardSize; row++ ) {
+	    for( int col=0; col<boardSize; col++ ) {
+		Bitboard mask;
+		for( int i=0; i<length; i++ ) mask.set((row+i)*boardSize + col);
+		startPlacement[length][Down][row*boardSize + col] = placementCount[length];
+		placements[length][placementCount[length]++] = mask;
+	    }
+	}
+	for( int i=0; i<placementCount[length]; i++ ) {
+	    Bitboard cells = placements[length][i];
+	    while( cells.any() ) {
+		int cell = cells.popFirst();
+		through[cell][length][throughCount[cell][length]++] = i;
+	    }
+	}
+    }
+    newRound();
+}
+
+void LayoutSampler::newRound() {
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) {
+	shipsLeft[length] = 0;
+	openStarts[length][Across] = openStarts[length][Down] = Bitboard();
+    }
+    blocked = Bitboard();
+    hits = Bitboard();
+}
+
+void LayoutSampler::addShip( int length ) {
+    if( length >= MIN_SHIP_SIZE && length <= MAX_SHIP_SIZE && length <= boardSize ) {
+	shipsLeft[length]++;
+    }
+}
+
+void LayoutSampler::miss( int row, int col ) {
+    blocked.set(row*boardSize + col);
+}
+
+void LayoutSampler::hit( int row, int col ) {
+    hits.set(row*boardSize + col);
+}
+
+void LayoutSampler::sunk( const Bitboard& cells ) {
+    hits = hits.andNot(cells);
+    blocked |= cells;
+    int length = cells.count();
+    if( length <= MAX_SHIP_SIZE && shipsLeft[length] > 0 ) {
+	shipsLeft[length]--;
+    }
+}
+
+void LayoutSampler::prepare() {
+    Bitboard shot = blocked | hits;
+    for( int length=MIN_SHIP_SIZE; length<=MAX_SHIP_SIZE; length++ ) {
+	for( int orientation=Across; orientation<=Down; orientation++ ) {
+	    Bitboard starts;
+	    for( int cell=0; shipsLeft[length] > 0 && cell<numCells(); cell++ ) {
+		int placement = startPlacement[length][orientation][cell];
+		if( placement >= 0 && !placements[length][placement].intersects(shot) ) starts.set(cell);
+	    }
+	    openStarts[length][orientation] = starts;
+	}
+    }
+}
+
+/*
+ * The weight of a layout is the number of ways there were to take each
+ * step, so it makes up for how unlikely the draw was to take those steps.
+ * Ships of the same length are told apart (the hits step picks one of
+ * them), which multiplies every layout's weight by the same amount.
+ */
+bool LayoutSampler::draw( Random& rng, double counts[] ) const {
+    int left[MAX_SHIP_SIZE+1];
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) left[length] = shipsLeft[length];
+    Bitboard taken;
+    double weight = 1;
+
+    for( Bitboard uncovered = hits; uncovered.any(); uncovered = hits.andNot(taken) ) {
+	int cell = uncovered.first();
+	Bitboard inWay = blocked | taken;
+	short pickLength[(MAX_SHIP_SIZE+1)*MaxThrough];
+	short pickIndex[(MAX_SHIP_SIZE+1)*MaxThrough];
+	int fits = 0, choices = 0;
+	for( int length=MIN_SHIP_SIZE; length<=MAX_SHIP_SIZE; length++ ) {
+	    if( left[length] == 0 ) continue;
+	    for( int i=0; i<throughCount[cell][length]; i++ ) {
+		const Bitboard& mask = placements[length][through[cell][length][i]];
+		if( mask.intersects(inWay) || mask.andNot(hits).empty() ) continue;
+		pickLength[fits] = length;
+		pickIndex[fits++] = through[cell][length][i];
+		choices += left[length];
+	    }
+	}
+	if( fits == 0 ) return false;
+	int pick = rng.below(choices);
+	int choice = 0;
+	while( (pick -= left[pickLength[choice]]) >= 0 ) choice++;
+	taken |= placements[pickLength[choice]][pickIndex[choice]];
+	left[pickLength[choice]]--;
+	weight *= choices;
+    }
+
+    for( int length=MAX_SHIP_SIZE; length>=MIN_SHIP_SIZE; length-- ) {
+	for( ; left[length] > 0; left[length]-- ) {
+	    Bitboard free( ~taken.lo, ~taken.hi );	// And the cells off the board, which no open start reaches
+	    Bitboard across = openStarts[length][Across] & free;
+	    Bitboard down = openStarts[length][Down] & free;
+	    for( int i=1; i<length; i++ ) {
+		across &= shiftDown(free, i);
+		down &= shiftDown(free, i*boardSize);
+	    }
+	    int acrossCount = across.count();
+	    int choices = acrossCount + down.count();
+	    if( choices == 0 ) return false;
+	    int pick = rng.below(choices);
+	    int placement = pick < acrossCount ? startPlacement[length][Across][nthCell(across, pick)]
+					       : startPlacement[length][Down][nthCell(down, pick - acrossCount)];
+	    taken |= placements[length][placement];
+	    weight *= choices;
+	}
+    }
+
+    Bitboard cells = taken.andNot(hits);
+    while( cells.any() ) counts[cells.popFirst()] += weight;
+    return true;
+}
+
+int LayoutSampler::bestCell( const double counts[] ) const {
+    int best = -1;
+    double bestCount = 0;
+    for( int cell=0; cell<numCells(); cell++ ) {
+	if( counts[cell] > bestCount ) {
+	    best = cell;
+	    bestCount = counts[cell];
+	}
+    }
+    return best;
+}
@@ -0,0 +1,100 @@
+/**
+ * LayoutSampler.h: random layouts of the opponent's fleet that fit the shots so far.
+ * Date:            October 2026
+ *
+ * Where DensityTargeter counts the placements of each ship on its own, a
+ * sampler draws whole layouts of the ships still afloat and counts how
+ * often each cell is under a ship, so ships crowding each other out is
+ * taken into account. A layout is built a ship at a time, each from the
+ * placements still open to it, so none is built and then thrown away:
+ *
+ *   - while some hit on a ship not sunk yet is not covered, a ship through
+ *     the first such hit, among every length still to place (a ship lying
+ *     on hits only would have been sunk, so those placements don't count);
+ *   - then the other ships, longest first, anywhere clear of the shots and
+ *     of the ships already drawn.
+ *
+ * That doesn't draw every layout equally often: one that needs few choices
+ * comes up more than one that needs many. So each layout counts with the
+ * product of the number of choices there were at each step, which makes the
+ * weighted counts estimate how likely each cell is to hold a ship as if
+ * every layout that fits were equally likely. The free ships' choices are
+ * counted a whole orientation at a time, with a mask of the start cells of
+ * open placements shifted against the cells still free.
+ *
+ * The fleet is whatever addShip() was told, as for DensityTargeter.
+ * Everything is sized in the constructor: drawing allocates nothing.
+ */
+
+#ifndef LAYOUTSAMPLER_H		// Double inclusion protection
+#define LAYOUTSAMPLER_H
+
+#include "defines.h"
+#include "Bitboard.h"
+#include "Random.h"
+
+class LayoutSampler {
+    public:
+	LayoutSampler( int boardSize );
+
+	/**
+	 * @brief Forgets all shots and the fleet.
+	 */
+	void newRound();
+
+	/**
+	 * @brief Adds a ship of the given length to the fleet being hunted.
+	 */
+	void addShip( int length );
+
+	// Shot results.
+	void miss( int row, int col );
+	void hit( int row, int col );
+	void sunk( const Bitboard& cells );	// Every cell of the sunk ship
+
+	/**
+	 * @brief Gets ready to draw for the next shot; call after the last
+	 * result, before draw().
+	 */
+	void prepare();
+
+	/**
+	 * @brief Draws a layout of the ships afloat and adds its weight to
+	 * counts[cell] for every cell it puts a ship on that hasn't been shot.
+	 * Draws only read the sampler, so several threads may draw at once,
+	 * each with its own rng and counts.
+	 * @return false, with counts as they were, if a ship found no room.
+	 */
+	bool draw( Random& rng, double counts[] ) const;
+
+	/**
+	 * @brief The cell with the highest count (row*boardSize+col), the first
+	 * of equals; -1 if no cell has any.
+	 */
+	int bestCell( const double counts[] ) const;
+
+	int numCells() const { return boardSize*boardSize; }
+
+	static const int MaxPlacements = 2*MAX_BOARD_SIZE*MAX_BOARD_SIZE;
+
+    private:
+	enum Orientation { Across, Down };
+	static const int MaxCells = MAX_BOARD_SIZE*MAX_BOARD_SIZE;
+	static const int MaxThrough = 2*MAX_SHIP_SIZE;	// Placements of a length through a cell
+
+	int boardSize;
+	Bitboard placements[MAX_SHIP_SIZE+1][MaxPlacements];	// By length: across, then down
+	int placementCount[MAX_SHIP_SIZE+1];
+	short through[MaxCells][MAX_SHIP_SIZE+1][MaxThrough];	// Placements covering a cell
+	unsigned char throughCount[MaxCells][MAX_SHIP_SIZE+1];
+	short startPlacement[MAX_SHIP_SIZE+1][2][MaxCells];	// Placement starting at a cell, by orientation
+
+	int shipsLeft[MAX_SHIP_SIZE+1];		// Fleet afloat, by length
+	Bitboard blocked;	// Misses and sunk ships
+	Bitboard hits;		// Hits on ships that are not sunk yet
+
+	// Set by prepare(): start cells of the placements clear of every shot.
+	Bitboard openStarts[MAX_SHIP_SIZE+1][2];
+};
+
+#endif
@@ -13,10 +13,10 @@
 
 #include <iostream>
 #include <cstdio>
-#include <fstream>
+#include <sstream>
 #include <vector>
 #include "Lewis.h"
-
+#include "Diagnostics.h"
 
 /**
  * @brief Constructor that initializes any inter-round data structures.
@@ -28,16 +28,22 @@
  * before rounds; newRound() gets called before every round.
  */
 Lewis::Lewis( int boardSize )
-	:PlayerV2(boardSize)
+	:PackedPlayerV2(boardSize), board(boardSize), oppShot(boardSize, 0), hunt(boardSize, 10),
+	 hunter(boardSize, hunt), memory(boardSize)
 {
     // Could do any initialization of inter-round data structures here.
-	/* Below transplanted from Deng.cpp */
-	for(int row=0; row<boardSize; row++) {
-		for(int col=0; col<boardSize; col++) {
-			this->shipHeatMap[row][col] = 0;
+	this -> roundNum = 0;
+	//Start from what earlier Lewises learnt about this opponent, if anything
+	if (memory.warmStart()){
+		const OpponentModel& model = memory.tables();
+		hunt.warmStart(model.heat, model.rounds);
+		for(int row = 0; row < boardSize; row++){
+			for(int col = 0; col < boardSize; col++){
+				oppShot[row][col] = model.shots[row*boardSize + col];
+			}
 		}
+		this -> roundNum = model.rounds;
 	}
-	this -> roundNum = 0;
 }
 
 /**
@@ -45,16 +51,32 @@ Lewis::Lewis( int boardSize )
  * If your code does anything that requires cleanup when the object is
  * destroyed, do it here in the destructor.
  */
-Lewis::~Lewis( ) {}
+Lewis::~Lewis( ) {
+	saveModel();
+}
 
 /*
- * Private internal function that initializes a MAX_BOARD_SIZE 2D array of char to water.
+ * Adds the heat map and oppShot learnt since the last save to the shared model.
+ */
+void Lewis::saveModel() {
+	if (!memory.active()) return;
+	OpponentModel& tables = memory.tables();
+	for(int row = 0; row < boardSize; row++){
+		for(int col = 0; col < boardSize; col++){
+			tables.heat[row*boardSize + col] = hunt.heat(row, col);
+			tables.shots[row*boardSize + col] = oppShot[row][col];
+		}
+	}
+	memory.commit();
+}
+
+/*
+ * Private internal function that initializes the board to water.
  */
 void Lewis::initializeBoard() {
 	for(int row=0; row<boardSize; row++) {
 		for(int col=0; col<boardSize; col++) {
 			//printf("setting up row %d col %d for boardSize %d\n",row,col,boardSize);
-			this->attackBoard[row][col] = WATER;
 			this->board[row][col] = WATER;
 		}
 	}
@@ -67,30 +89,9 @@ void Lewis::initializeBoard() {
  * See the Message class documentation for more information on the 
  * Message constructor.
  */
-Message Lewis::getMove() {	
-	/* Below transplanted from Deng */
- 	Message result( SHOT, -1, -1, "", None, 1 ); // default result
-	if (!isHit(sourceRow,sourceCol)) // if the source is no longer a HIT, reset source to none
-	{
-		sourceRow = -1;
-		sourceCol = -1;
-	}
-	if (sourceRow == -1 && sourceCol == -1) // if no existing source
-		toHit(sourceRow, sourceCol); // try setting the source to existing HIT
-	if (sourceRow == -1 && sourceCol == -1) // if no source, scan shoot or max shoot
-	{
-		refreshScanShootBoard();
-		if (roundNum>=10) { // if already 10+ rounds 
-			result = getMaxShoot();
-		}
-		else { // if not yet 10 rounds
-			result = this->getScanShoot();
-		}
-	}
-	else // if found a HIT
-	{
-		result = this->getTargetShoot(sourceRow, sourceCol);
-	}
+PackedMessage Lewis::getPackedMove() {	
+	/* Shooting as Deng does */
+	PackedMessage result = hunter.nextShot(rng); // Target Shoot around open hits, else hunt
 
 	lastRow = result.getRow();
 	lastCol = result.getCol();
@@ -109,23 +110,23 @@ void Lewis::newRound() {
     this->numShipsPlaced = 0;
     this->initializeBoard();
 	this->shotCount = 0;
-	/* Below transplanted from Deng */
-	this->initializeScanShootBoard();
-
-	this->sourceRow = -1; // no source at beginning
-	this->sourceCol = -1;
+	if (memory.due()) saveModel();	//Before counting this round, which isn't played yet
+	memory.roundStarted();
+	/* Shooting as Deng does */
+	this->hunter.newRound();
 	this->roundNum += 1;
 	//Print the heat map to a file
-	ofstream logFile;
-	logFile.open("heatMap.txt");
-	for(int row = 0; row < boardSize; row++){
-		for(int col = 0; col < boardSize; col++){
-			logFile << "." << oppShot[row][col];
+	if (Diagnostics::Enabled) {
+		ostringstream logFile;
+		for(int row = 0; row < boardSize; row++){
+			for(int col = 0; col < boardSize; col++){
+				logFile << "." << oppShot[row][col];
+			}
+			logFile << std::endl;
 		}
 		logFile << std::endl;
+		Diagnostics::write("heatMap.txt", logFile.str());
 	}
-	logFile << std::endl;
-	logFile.close();
 }
 /**
  * @brief Gets the AI's ship placement choice. This is then returned to the caller.
@@ -152,7 +153,7 @@ Lewis::position Lewis::placeCorner(int length){
 	int orientation = 1;
 	//Decide which of 8 corner placements we want to select
 	bool isLegal = true;
-	int positionSwitch = (rand() % 10);
+	int positionSwitch = rng.below(10);
 	switch(positionSwitch){
 		case 0:
 			row = 1;
@@ -220,7 +221,7 @@ Lewis::position Lewis::placeCorner(int length){
 		//Up
 		case 0:
 			for(int i = 0; i < length; i++){
-				if(this->board[row-i][col]==SHIP || row-i < 0){
+				if(row-i < 0 || this->board[row-i][col]==SHIP){
 					isLegal = false;
 				}
 			}
@@ -228,7 +229,7 @@ Lewis::position Lewis::placeCorner(int length){
 		//Right
 		case 1:
 			for(int i = 0; i < length; i++){
-				if(this->board[row][col+i]==SHIP || col+i >= boardSize){
+				if(col+i >= boardSize || this->board[row][col+i]==SHIP){
 					isLegal = false;
 				}
 			}
@@ -236,7 +237,7 @@ Lewis::position Lewis::placeCorner(int length){
 		//Down
 		case 2:
 			for(int i = 0; i < length; i++){
-				if(this->board[row+i][col]==SHIP || row+i >= boardSize){
+				if(row+i >= boardSize || this->board[row+i][col]==SHIP){
 					isLegal = false;
 				}
 			}
@@ -244,7 +245,7 @@ Lewis::position Lewis::placeCorner(int length){
 		//Left
 		case 3:
 			for(int i = 0; i < length; i++){
-				if(this->board[row][col-i]==SHIP || col-i < 0){
+				if(col-i < 0 || this->board[row][col-i]==SHIP){
 					isLegal = false;
 				}
 			}
@@ -310,10 +311,10 @@ Lewis::position Lewis::placeHeatMap(int length){
 				bool isVertical = true;
 				//Check to see if at this spot the ship can be placed horizontally or vertically
 				for(int i = 0; i < length; i++){
-					if(this->board[row+i][col] == SHIP || row+i>(boardSize-1)){
+					if(row+i>(boardSize-1) || this->board[row+i][col] == SHIP){
 						isVertical = false;
 					}
-					if(this->board[row][col+i] == SHIP || col+i>(boardSize-1)){
+					if(col+i>(boardSize-1) || this->board[row][col+i] == SHIP){
 						isHorizontal = false;
 					}
 				}
@@ -346,7 +347,7 @@ Lewis::position Lewis::placeHeatMap(int length){
 	}
 	return newPosition;
 }
-Message Lewis::placeShip(int length) {
+PackedMessage Lewis::placePackedShip(int length) {
 
 
 	//Goal: Place ships towards the outside squares where less players will guess
@@ -354,8 +355,6 @@ Message Lewis::placeShip(int length) {
 	int newRow = 0;
 	int newCol = 0;
 	bool isVertical = false;
-	std::fstream logFile;
-	logFile.open("shipMap.txt",ios::app);
 	//Randomly select a row and col to start
 	if (numShipsPlaced<1){
 		position newPos;
@@ -370,9 +369,9 @@ Message Lewis::placeShip(int length) {
 	}else if (roundNum < 5){
 		while(isLegal == false){
 			//Setup a random assignment
-			newRow = rand() % boardSize;
-			newCol = rand() % boardSize;
-			if (rand() % 2 == 0){
+			newRow = rng.below(boardSize);
+			newCol = rng.below(boardSize);
+			if (rng.below(2) == 0){
 				isVertical = true;	
 			}else{
 				isVertical = false;
@@ -384,7 +383,7 @@ Message Lewis::placeShip(int length) {
 					isLegal = true;
 				}
 				//Check to see if we run into another ship or if we hit a deadzone
-				for(int i = 0; i < length; i++){
+				for(int i = 0; isLegal && i < length; i++){
 					if(this->board[newRow+i][newCol] == SHIP){
 						isLegal = false;
 					}
@@ -394,7 +393,7 @@ Message Lewis::placeShip(int length) {
 					isLegal = true;
 				}
 				//Check to see if we run into another ship
-				for(int i = 0; i < length; i++){
+				for(int i = 0; isLegal && i < length; i++){
 					if(this->board[newRow][newCol+i] == SHIP){
 						isLegal = false;
 					}
@@ -424,7 +423,7 @@ Message Lewis::placeShip(int length) {
 	}else{
 		orientation = Horizontal;
 	}
-	Message response( PLACE_SHIP, newRow, newCol, shipName, orientation, length );
+	PackedMessage response( PLACE_SHIP, newRow, newCol, orientation, length, MessageLabels::intern(shipName) );
 	//Once we've placed the ship, we need to keep track of its' location internally
 	for(int i = 0; i < length; i++){
 		if (isVertical==true){
@@ -434,14 +433,17 @@ Message Lewis::placeShip(int length) {
 		}
 	}
 	//print ships
-	for(int row = 0; row < boardSize; row++){
-		for(int col = 0; col < boardSize; col++){
-			logFile << this->board[row][col];
+	if (Diagnostics::Enabled) {
+		ostringstream logFile;
+		for(int row = 0; row < boardSize; row++){
+			for(int col = 0; col < boardSize; col++){
+				logFile << this->board[row][col];
+			}
+			logFile << std::endl;
 		}
 		logFile << std::endl;
+		Diagnostics::append("shipMap.txt", logFile.str());
 	}
-	logFile << std::endl;
-	logFile.close();
 	numShipsPlaced++;
 
     return response;
@@ -451,21 +453,15 @@ Message Lewis::placeShip(int length) {
  * @brief Updates the AI with the results of its shots and where the opponent is shooting.
  * @param msg Message specifying what happened + row/col as appropriate.
  */
-void Lewis::update(Message msg) {
+void Lewis::updatePacked(PackedMessage msg) {
     switch(msg.getMessageType()) {
 	case HIT:
-		/* Below transplanted from Deng */
-		shipHeatMap[msg.getRow()][msg.getCol()]++;
-	    attackBoard[msg.getRow()][msg.getCol()] = msg.getMessageType();
-		break;
 	case KILL:
-		/* Below transplanted from Deng */
-	    attackBoard[msg.getRow()][msg.getCol()] = msg.getMessageType();
+	    hunter.update(msg);
 		break;
 	case MISS:
 	    board[msg.getRow()][msg.getCol()] = msg.getMessageType();
-		/* Below transplanted from Deng */
-	    attackBoard[msg.getRow()][msg.getCol()] = msg.getMessageType();
+	    hunter.update(msg);
 	    break;
 	case WIN:
 	    break;
@@ -482,241 +478,11 @@ void Lewis::update(Message msg) {
 	    break;
     }
 }
-/* Below transplanted from Deng */
-
-/**
- * @return a Message indicating which place to attack, according to scanShootBoard
- */
-Message Lewis::getScanShoot(){ // to shoot according to scanShootBoard, modifying the shot place, and return a Message
-	int scanID = rand() % scanShootCount; // generate a random number between 0 and scanShootCount-1
-	for (int i=0; i<boardSize; i++)
-		for (int j=0; j<boardSize; j++)
-		{
-			if (scanShootBoard[i][j] == true) { // if found a spot to be shot
-				if (scanID == 0) { // if reaching the ID, return this spot
-					scanShootBoard[i][j] = false;
-					scanShootCount--;
-					return Message( SHOT, i, j, "Scan Shooting", None, 1);
-				}
-				else // if not yet reached
-				{
-					scanID--;
-				}
-			}
-		}
-	return Message( SHOT, 0, 0, "RUNOUT", None, 1);
-}
-
-
-/**
- * @brief Initialize scanShootBoard to be shooted in a scanning pattern
- */
-void Lewis::initializeScanShootBoard() {
-	// initial coordinates to false
-//	ofstream f;
-//	f.open("scanBoardLog.txt");
-	scanShootCount = 0;
-	for (int i=0; i<boardSize; i++)
-		for (int j=0; j<boardSize; j++)
-			scanShootBoard[i][j] = false;
-
-	int row = 0;
-	int col = 1;
-	int startCol = 2; // the column number to start at each row, vary between 0-2
-	while (row < boardSize) // as long as the row number is valid, keep going down
-	{
-		do {
-			scanShootBoard[row][col] = true; // switch the position to true
-			scanShootCount++; // increment the counting
-			col+=3; // move to the next col position
-		}
-		while (col < boardSize);  // whenever the col is inside the board
-		col=startCol; // go to the startCol
-		startCol==2 ? startCol=0 : startCol++; // update startCol
-		row++; // update the rol number
-	}
-	
-// debug: print the board
-//	for (int i=0; i<boardSize; i++) {
-//		for (int j=0; j<boardSize; j++)
-//		{
-//			f << int(scanShootBoard[i][j]) << " ";
-//		}
-//		f << endl;
-//	}
-//	f << "Writing end.\n";
-//	f.close();
-}
-
-/*
-* @brief refresh scanShootBoard according to the condition in the actual board
-*/
-void Lewis::refreshScanShootBoard() {
-	for (int i=0; i<boardSize; i++)
-		for (int j=0; j<boardSize; j++)
-		{
-			if (this->scanShootBoard[i][j] == true &&
-					this->attackBoard[i][j] != WATER) // if in scanShootBoard valid, but in board invalid
-			{
-				this->scanShootBoard[i][j] = false; // update it to invalid
-				this->scanShootCount--; // decrement the count
-			}
-		}
-}
-
 
 /**
- * @brief Modify the parameter to the first found HIT in the board, set to -1, -1 if not found
+ * @brief Takes a sunk ship in one go: the HIT for the last shot, then every cell as a KILL.
+ * @param kill The shot that sank the ship and all of its cells.
  */
-void Lewis::toHit(int& row, int& col)
-{
-	for (int i=0; i<boardSize; i++)
-		for (int j=0; j<boardSize; j++)
-		{
-			if (attackBoard[i][j] == HIT)
-			{
-				row = i;
-				col = j;
-				return;
-			}
-		}
-	row = -1;
-	col = -1;
-	return;
-}
-
-
-/**
- * @brief return a place to shoot, given the source HIT
- * @param row of the source HIT
- * @param col of the source HIT
- *
- * Requirements:
- * 1. The given coordinate is a HIT ( not a KILL )
- * 2. The gameboard is in a valid state ( since the ship at source HIT is not killed, a possible shot will be found if searching through all four directions.
- */
-Message Lewis::getTargetShoot(int row, int col)
-{
-	searchDirection currDir = up; // initial search direction
-	bool directionsValidity[4] = {true, true, true, true}; // set all directions to valid
-	int currRow = row;
-	int currCol = col;
-	while(1)
-	{
-		if (directionsValidity[currDir] == false) // if the current direction is invalid
-		{
-			currDir = getAdjDirection(currDir); // go to adjacent direction
-			continue;
-		}
-		if (isWater(getNextRow(currDir,currRow),getNextCol(currDir,currCol))) // if the next coord is water, shoot!
-		{
-			toNext(currDir,currRow,currCol); // go to next coord along direction
-			return Message( SHOT, currRow, currCol, "Target Shooting", None, 1);
-		}
-		else if (isHit(getNextRow(currDir,currRow),getNextCol(currDir,currCol))) // if next coord is shot, go again to the next
-		{
-			toNext(currDir,currRow,currCol); // go to next coord along direction
-			continue;
-		}
-		else // if neither water nor shot ( meaning the same ship can't extend to that spot )
-		{
-			directionsValidity[currDir] = false; // set current direction to invalid
-			if (currRow == row && currCol == col) // if this is the source HIT, search priority is adjacent direction
-			{
-				currDir = getAdjDirection(currDir);
-				continue;
-			}
-			else // if there are shots after source already, search priority is opposite
-			{
-				currDir = getOppDirection(currDir);
-				currRow = row;
-				currCol = col;
-				continue;
-			}
-		}
-	}
-}
-
-
-bool Lewis::isValid(int row, int col)
-{
-	return row<boardSize &&
-		row>=0 &&
-		col<boardSize &&
-		col>=0;
-}
-bool Lewis::isWater(int row, int col)
-{
-	return isValid(row,col) &&
-		this->attackBoard[row][col] == WATER;
-}
-bool Lewis::isHit(int row, int col)
-{
-	return isValid(row,col) &&
-		this->attackBoard[row][col] == HIT;
-}
-
-void Lewis::toNext(searchDirection dir, int& row, int& col)
-{
-	row = getNextRow(dir, row);
-	col = getNextCol(dir, col);
-}
-
-int Lewis::getNextRow(searchDirection dir, int row)
-{
-	switch (dir) {
-		case up:
-			return row-1;
-		case down:
-			return row+1;
-		default:
-			return row;
-	}
-}
-
-int Lewis::getNextCol(searchDirection dir, int col)
-{
-	switch (dir) {
-		case left:
-			return col-1;
-		case right:
-			return col+1;
-		default:
-			return col;
-	}
-}
-
-Lewis::searchDirection Lewis::getAdjDirection(searchDirection d)
-{
-	return searchDirection (d+1>=4 ? d-3 : d+1);
-}
-Lewis::searchDirection Lewis::getOppDirection(searchDirection d)
-{
-	return searchDirection (d+2>=4 ? d-2 : d+2);
-}
-
-/** @brief Get a most shot position from the scanShootBoard
-    Intended to be used after shipHeatMap is matured ( after 10 rounds maybe )
-    as a replacement of getScanShoot()
-
-    @return a Message object with the most shot position, return 0,0 if position not found
-*/
-Message Lewis::getMaxShoot() {
-	int maxRow = 0;
-	int maxCol = 0;
-	int maxHeat = -1;
-	for (int i=0; i<boardSize; i++)
-		for (int j=0; j<boardSize; j++)
-		{
-			if (scanShootBoard[i][j] == true) // if spot available
-			{
-				if (shipHeatMap[i][j] > maxHeat) // if that position has greater heat
-				{
-					maxRow = i;
-					maxCol = j;
-					maxHeat = shipHeatMap[i][j];
-				}
-			}
-		}
-	return Message( SHOT, maxRow, maxCol, "Max Shooting", None, 1);
+void Lewis::updateKill(const ShipKill& kill) {
+    hunter.sunk(kill);
 }
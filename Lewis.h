@@ -11,30 +11,35 @@
 
 using namespace std;
 
-#include "PlayerV2.h"
-#include "Message.h"
+#include "PackedPlayerV2.h"
+#include "PackedMessage.h"
+#include "Grid.h"
+#include "HuntTarget.h"
+#include "OpponentModels.h"
 #include "defines.h"
 #include <fstream>
 
 // DumbPlayer inherits from/extends PlayerV2
 
-class Lewis: public PlayerV2 {
+class Lewis: public PackedPlayerV2 {
 	public:
 		Lewis( int boardSize );
 		~Lewis();
 		void newRound() override;
-		Message placeShip(int length) override;
-		Message getMove() override;
-		void update(Message msg) override;
+		PackedMessage placePackedShip(int length) override;
+		PackedMessage getPackedMove() override;
+		void updatePacked(PackedMessage msg) override;
+		void updateKill(const ShipKill& kill) override;
 
 	private:
 		void initializeBoard();
+		void saveModel();
 		int lastRow;
 		int lastCol;
 		int numShipsPlaced;
-		char board[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+		Grid<char> board;
 		//oppShot keeps track of how many times the opponent has shot at each spot
-		int oppShot[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
+		Grid<int> oppShot;
 		//position struct to more easily store row col positions
 		struct position {
 			int row;
@@ -49,32 +54,12 @@ class Lewis: public PlayerV2 {
 		int getDirection(int row, int col, int length);
 		//shotCount tracks number of opponent hits each round
 		int shotCount;
-		/* below transplanted from Deng */
-		char attackBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
-		/* Scan Shoot */
-		bool scanShootBoard[MAX_BOARD_SIZE][MAX_BOARD_SIZE]; // to store whether the position is to be shooted by scanShoot()
-		Message getScanShoot(); // to shoot according to scanShootBoard, modifying the shot place, and return a Message
-		int scanShootCount; // to track how many block are available to be scan shooted
-		void initializeScanShootBoard();
-		void refreshScanShootBoard();
-		/* Target Shoot */
-		int sourceRow;
-		int sourceCol;
-		void toHit(int& row, int& col);
-		enum searchDirection { up=0, right=1, down=2, left=3 };
-		Message getTargetShoot(int rol, int col);
-		bool isValid(int row, int col);
-		bool isWater(int row, int col);
-		bool isHit(int row, int col);
-		int getNextRow(searchDirection dir, int row);
-		int getNextCol(searchDirection dir, int col);
-		void toNext(searchDirection, int& row, int& col);
-		searchDirection getAdjDirection(searchDirection);
-		searchDirection getOppDirection(searchDirection);
-		/* Learning Ship Placement: Max shoot */
+		/* Shooting as Deng does: Scan Shoot for 10 rounds, then Max Shoot; Target Shoot around hits */
 		int roundNum;
-		int shipHeatMap[MAX_BOARD_SIZE][MAX_BOARD_SIZE];
-		Message getMaxShoot();
+		HeatMapHunt hunt;
+		HuntTarget hunter;
+		//memory shares the heat map and oppShot with other Lewises facing the same opponent (--models)
+		OpponentMemory memory;
 };
 
 #endif
@@ -0,0 +1,220 @@
+/**
+ * MatchRunner.cpp: plays the rounds of AI matches, on one thread or many.
+ * Date:            October 2026
+ */
+
+#include <iostream>
+#include <thread>
+#include <atomic>
+
+#include "MatchRunner.h"
+#include "AIContest.h"
+#include "Random.h"
+#include "OpponentModels.h"
+
+using namespace std;
+
+MatchStats::MatchStats() {
+    ties = 0;
+    for(int side=0; side<2; side++) {
+	wins[side] = 0;
+	shotsTaken[side] = 0;
+	gamesCounted[side] = 0;
+    }
+}
+
+void MatchStats::add( const MatchStats& other ) {
+    ties += other.ties;
+    for(int side=0; side<2; side++) {
+	wins[side] += other.wins[side];
+	shotsTaken[side] += other.shotsTaken[side];
+	gamesCounted[side] += other.gamesCounted[side];
+    }
+    if( !other.timing.empty() ) {
+	timing.resize(2);
+	timing[0].add(other.timing[0]);
+	timing[1].add(other.timing[1]);
+    }
+}
+
+MatchRunner::MatchRunner( PlayerFactory getPlayer, const string playerNames[], int boardSize, unsigned int seed,
+                          BoardFactory makeBoard )
+{
+    this->getPlayer = getPlayer;
+    this->playerNames = playerNames;
+    this->boardSize = boardSize;
+    this->seed = seed;
+    this->makeBoard = makeBoard;
+    this->log = 0;
+    this->timing = false;
+    this->sandbox = 0;
+}
+
+PlayerV2* MatchRunner::makePlayer( int playerId ) {
+    if( sandbox ) return new SandboxPlayer(getPlayer, playerId, boardSize, playerNames[playerId], *sandbox);
+    return getPlayer(playerId, boardSize);
+}
+
+MatchStats MatchRunner::play( const MatchJob& job, int displayRound, bool displayOthers,
+                              float secondsPerMove, ostream* report, bool reportLastOnly )
+{
+    AIContest game( boardSize, makeBoard );
+    return play( game, job, displayRound, displayOthers, secondsPerMove, report, reportLastOnly );
+}
+
+MatchStats MatchRunner::play( AIContest& game, const MatchJob& job, int displayRound, bool displayOthers,
+                              float secondsPerMove, ostream* report, bool reportLastOnly )
+{
+    return playRounds( game, job, displayRound, displayOthers, secondsPerMove, report, reportLastOnly, 0,
+                       MatchStats() );
+}
+
+/*
+ * Plays the job's rounds, stopping early once test (if any) decides the
+ * results of earlier rounds plus these.
+ */
+MatchStats MatchRunner::playRounds( AIContest& game, const MatchJob& job, int displayRound, bool displayOthers,
+                                    float secondsPerMove, ostream* report, bool reportLastOnly,
+                                    const SequentialTest* test, const MatchStats& earlier )
+{
+    MatchStats stats;
+    int totalMoves = 0;
+    bool player1Won, player2Won;
+    PlayerTiming* player1Timing = 0;
+    PlayerTiming* player2Timing = 0;
+    if( timing ) {
+	stats.timing.resize(2);
+	player1Timing = &stats.timing[0];
+	player2Timing = &stats.timing[1];
+    }
+
+    // Round -1 seeds whatever the player constructors draw. Each learns who
+    // it plays, for the opponent models (--models).
+    seedThreadRandom(mixSeed(seed, job.pairing, job.firstRound, -1));
+    OpponentModels::setOpponent(&playerNames[job.player2Id]);
+    PlayerV2* player1 = makePlayer(job.player1Id);
+    OpponentModels::setOpponent(&playerNames[job.player1Id]);
+    PlayerV2* player2 = makePlayer(job.player2Id);
+    OpponentModels::setOpponent(0);
+    game.setPlayers( player1, playerNames[job.player1Id], player2, playerNames[job.player2Id] );
+    game.setLog(log);
+    game.setTiming(player1Timing, player2Timing);
+
+    for( int round=job.firstRound; round<job.firstRound+job.numRounds; round++ ) {
+	seedThreadRandom(mixSeed(seed, job.pairing, round));
+	player1Won = false; player2Won = false;
+	{
+	    CallTimer timer(player1Timing, NewRoundCall);
+	    player1->newRound();
+	}
+	{
+	    CallTimer timer(player2Timing, NewRoundCall);
+	    player2->newRound();
+	}
+
+	GameId id = { seed, job.pairing, round };
+	game.reset(id);
+	game.setSilent(round != displayRound && !displayOthers);
+	game.setReport(!reportLastOnly || round == job.firstRound+job.numRounds-1 ? report : 0);
+	game.play( round == displayRound ? secondsPerMove : 0, totalMoves, player1Won, player2Won );
+
+	if((player1Won && player2Won) || !(player1Won || player2Won)) {
+	    stats.ties++;
+	    stats.shotsTaken[0] += totalMoves;
+	    stats.gamesCounted[0]++;
+	    stats.shotsTaken[1] += totalMoves;
+	    stats.gamesCounted[1]++;
+	} else if( player1Won ) {
+	    stats.wins[0]++;
+	    stats.shotsTaken[0] += totalMoves;
+	    stats.gamesCounted[0]++;
+	} else if( player2Won ) {
+	    stats.wins[1]++;
+	    stats.shotsTaken[1] += totalMoves;
+	    stats.gamesCounted[1]++;
+	}
+	if( test && test->decide(earlier.wins[0] + stats.wins[0], earlier.wins[1] + stats.wins[1]) != Undecided ) {
+	    break;
+	}
+    }
+    delete player1;
+    delete player2;
+
+    return stats;
+}
+
+void MatchRunner::playAll( const vector<MatchJob>& jobs, vector<MatchStats>& results, int threads ) {
+    results.assign(jobs.size(), MatchStats());
+    if( threads < 1 ) threads = 1;
+    if( threads > (int)jobs.size() ) threads = jobs.size();
+
+    // Workers claim jobs in order; each result lands in its job's slot, so
+    // the caller can reduce them in job order regardless of timing.
+    atomic<size_t> nextJob(0);
+    vector<thread> pool;
+    for(int t=0; t<threads; t++) {
+	pool.push_back(thread([&]() {
+	    AIContest game( boardSize, makeBoard );	// This worker's, for all its jobs
+	    for(size_t i=nextJob++; i<jobs.size(); i=nextJob++) {
+		results[i] = play(game, jobs[i], -1, false, 0, 0);
+	    }
+	}));
+    }
+    for(size_t t=0; t<pool.size(); t++) {
+	pool[t].join();
+    }
+}
+
+void MatchRunner::playUntilDecided( const vector<vector<MatchJob> >& matches, const SequentialTest& test,
+                                    vector<MatchStats>& results, int threads )
+{
+    results.resize(matches.size());
+    if( threads < 1 ) threads = 1;
+    if( threads > (int)matches.size() ) threads = matches.size();
+
+    // A match's rounds must be played in order to know where to stop, so
+    // workers claim whole matches.
+    atomic<size_t> nextMatch(0);
+    vector<thread> pool;
+    for(int t=0; t<threads; t++) {
+	pool.push_back(thread([&]() {
+	    AIContest game( boardSize, makeBoard );
+	    for(size_t i=nextMatch++; i<matches.size(); i=nextMatch++) {
+		for(size_t j=0; j<matches[i].size(); j++) {
+		    if( test.decide(results[i].wins[0], results[i].wins[1]) != Undecided ) break;
+		    results[i].add(playRounds(game, matches[i][j], -1, false, 0, 0, false, &test, results[i]));
+		}
+	    }
+	}));
+    }
+    for(size_t t=0; t<pool.size(); t++) {
+	pool[t].join();
+    }
+}
+
+void MatchRunner::addJobs( vector<MatchJob>& jobs, int pairing, int player1Id, int player2Id,
+                           int totalRounds, int blockSize, int firstRound )
+{
+    if( blockSize <= 0 ) blockSize = totalRounds;
+    for( int first=0; first<totalRounds; first+=blockSize ) {
+	MatchJob job;
+	job.pairing = pairing;
+	job.player1Id = player1Id;
+	job.player2Id = player2Id;
+	job.firstRound = firstRound + first;
+	job.numRounds = first+blockSize <= totalRounds ? blockSize : totalRounds-first;
+	jobs.push_back(job);
+    }
+    if( totalRounds <= 0 ) {
+	MatchJob job = { pairing, player1Id, player2Id, firstRound, 0 };
+	jobs.push_back(job);
+    }
+}
+
+MatchJob MatchRunner::replayJob( int pairing, int player1Id, int player2Id, int round, int blockSize ) {
+    // The players' memory of earlier rounds is part of the game, so start
+    // where the round's block started.
+    int first = blockSize > 0 ? round - round % blockSize : 0;
+    MatchJob job = { pairing, player1Id, player2Id, first, round - first + 1 };
+    return job;
+}
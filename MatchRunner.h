@@ -0,0 +1,153 @@
+/**
+ * MatchRunner.h: plays the rounds of AI matches, on one thread or many.
+ * Date:          October 2026
+ *
+ * A match is split into jobs: a block of consecutive rounds between two
+ * players, played with one pair of freshly created player objects. Every
+ * job reseeds the thread's random stream from (seed, pairing, round), so
+ * its result does not depend on the thread that played it. Running the same
+ * jobs with one thread or with a pool of threads gives identical results.
+ * Each round is played as game (seed, pairing, round); see Random.h.
+ *
+ * One AIContest, with its boards, is reset for every round of a job, and
+ * each pool thread keeps its own for all its jobs, so after the first round
+ * playing a round allocates nothing beyond what the players do.
+ *
+ * With a SequentialTest, playUntilDecided() plays a match's jobs in order
+ * and stops after the first round at which the test decides the match, so
+ * the rounds it plays are exactly the first rounds of the full match.
+ */
+
+#ifndef MATCHRUNNER_H		// Double inclusion protection
+#define MATCHRUNNER_H
+
+#include <string>
+#include <vector>
+
+#include "PlayerV2.h"
+#include "GameBoard.h"
+#include "GameLog.h"
+#include "PlayerTiming.h"
+#include "SequentialTest.h"
+#include "Sandbox.h"
+
+using namespace std;
+
+class AIContest;
+
+typedef PlayerV2* (*PlayerFactory)( int playerId, int boardSize );
+
+/**
+ * @brief Results of one job or of a whole match, indexed by side (0 = player 1).
+ */
+struct MatchStats {
+    MatchStats();
+    void add( const MatchStats& other );
+    int rounds() const { return wins[0] + wins[1] + ties; }
+
+    int wins[2];		// Rounds won by each side
+    int ties;			// Rounds nobody (or both) won
+    long shotsTaken[2];		// Moves of the rounds counted for each side
+    int gamesCounted[2];	// Rounds counted for each side (won or tied)
+    vector<PlayerTiming> timing;	// Call times per side, if the runner times calls
+};
+
+/**
+ * @brief A block of rounds between two players.
+ */
+struct MatchJob {
+    int pairing;		// Position of the match in the tournament
+    int player1Id;
+    int player2Id;
+    int firstRound;
+    int numRounds;
+};
+
+class MatchRunner {
+  public:
+    /**
+     * @param makeBoard Makes the games' boards; null for BoardV3.
+     */
+    MatchRunner( PlayerFactory getPlayer, const string playerNames[], int boardSize, unsigned int seed,
+                 BoardFactory makeBoard = 0 );
+
+    /**
+     * @brief Records every game played from now on in log (null for none).
+     */
+    void setLog( GameLogWriter* log ) { this->log = log; }
+
+    /**
+     * @brief Times every player call (see PlayerTiming.h) into MatchStats::timing.
+     */
+    void setTiming( bool timing ) { this->timing = timing; }
+
+    /**
+     * @brief Runs every player in its own process within limits (see
+     * Sandbox.h); null, the default, runs them in this one.
+     */
+    void setSandbox( const SandboxLimits* limits ) { this->sandbox = limits; }
+
+    /**
+     * @brief Plays one job on the calling thread.
+     * @param displayRound Round shown on screen at secondsPerMove, -1 for none.
+     * @param displayOthers Show the other rounds too (without delay).
+     * @param report Where per-round results go; null for none.
+     * @param reportLastOnly Report only the job's last round.
+     */
+    MatchStats play( const MatchJob& job, int displayRound, bool displayOthers,
+                     float secondsPerMove, ostream* report, bool reportLastOnly = false );
+
+    /**
+     * @brief The same, reusing game (made for this runner's board size and
+     * factory) instead of making a contest.
+     */
+    MatchStats play( AIContest& game, const MatchJob& job, int displayRound, bool displayOthers,
+                     float secondsPerMove, ostream* report, bool reportLastOnly = false );
+
+    /**
+     * @brief Plays all jobs silently on a pool of threads.
+     * @param results Receives one MatchStats per job, in job order.
+     */
+    void playAll( const vector<MatchJob>& jobs, vector<MatchStats>& results, int threads );
+
+    /**
+     * @brief Plays silently, on a pool of threads, each match's jobs in
+     * order until test decides the match.
+     * @param matches The jobs of each match; one thread plays a whole match.
+     * @param results One MatchStats per match. The results of rounds played
+     * before these count towards the test, and the new rounds are added.
+     */
+    void playUntilDecided( const vector<vector<MatchJob> >& matches, const SequentialTest& test,
+                           vector<MatchStats>& results, int threads );
+
+    /**
+     * @brief Splits a match into jobs of at most blockSize rounds (0 = one job).
+     * @param firstRound Where the jobs start, for rounds added to a match.
+     */
+    static void addJobs( vector<MatchJob>& jobs, int pairing, int player1Id, int player2Id,
+                         int totalRounds, int blockSize, int firstRound = 0 );
+
+    /**
+     * @brief The job that replays one round of a match: the round's block up
+     * to and including the round. Play it with reportLastOnly and, to watch
+     * it, displayRound = round.
+     */
+    static MatchJob replayJob( int pairing, int player1Id, int player2Id, int round, int blockSize );
+
+  private:
+    MatchStats playRounds( AIContest& game, const MatchJob& job, int displayRound, bool displayOthers,
+                           float secondsPerMove, ostream* report, bool reportLastOnly,
+                           const SequentialTest* test, const MatchStats& earlier );
+    PlayerV2* makePlayer( int playerId );
+
+    PlayerFactory getPlayer;
+    const string* playerNames;
+    int boardSize;
+    unsigned int seed;
+    BoardFactory makeBoard;
+    GameLogWriter* log;
+    bool timing;
+    const SandboxLimits* sandbox;
+};
+
+#endif
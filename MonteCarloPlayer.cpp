@@ -0,0 +1,122 @@
+/**
+ * MonteCarloPlayer.cpp: a player that shoots where most sampled layouts put a ship.
+ * Date:                 October 2026
+ */
+
+#include <chrono>
+#include <sstream>
+
+#include "MonteCarloPlayer.h"
+#include "Diagnostics.h"
+
+namespace {
+    const int DrawsPerCheck = 8;	// Layouts drawn between looks at the clock
+}
+
+MonteCarloPlayer::MonteCarloPlayer( int boardSize, int budgetMicros, int threads, int samplesPerMove )
+    :DensityPlayer(boardSize), sampler(boardSize), pool(threads)
+{
+    this->budgetMicros = budgetMicros;
+    this->samplesPerMove = samplesPerMove;
+    this->samples = 0;
+    this->moves = 0;
+    this->samplingNanos = 0;
+}
+
+/**
+ * @brief Leaves the sampling rate in monteCarlo.txt.
+ */
+MonteCarloPlayer::~MonteCarloPlayer() {
+    if( Diagnostics::Enabled && moves > 0 ) {
+	ostringstream text;
+	text << "Monte Carlo Player, " << boardSize << "x" << boardSize << ", budget ";
+	if( samplesPerMove > 0 ) text << samplesPerMove << " draws";
+	else text << budgetMicros << "us";
+	text << ", " << pool.size() << " threads: " << samples << " layouts in " << moves << " shots, "
+	     << (long long)samplesPerSecond() << " layouts/s" << endl;
+	Diagnostics::append("monteCarlo.txt", text.str());
+    }
+}
+
+double MonteCarloPlayer::samplesPerSecond() const {
+    return samplingNanos > 0 ? samples * 1e9 / samplingNanos : 0;
+}
+
+void MonteCarloPlayer::newRound() {
+    DensityPlayer::newRound();
+    sampler.newRound();
+}
+
+/**
+ * @brief Learns the fleet from our own ships: both fleets are the same.
+ */
+PackedMessage MonteCarloPlayer::placePackedShip( int length ) {
+    sampler.addShip(length);
+    return DensityPlayer::placePackedShip(length);
+}
+
+PackedMessage MonteCarloPlayer::getPackedMove() {
+    typedef chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    deadline = start + chrono::microseconds(budgetMicros);
+
+    sampler.prepare();
+    for( int part=0; part<pool.size(); part++ ) {
+	partials[part].rng = Random(rng.next());
+	partials[part].samples = 0;
+	for( int cell=0; cell<sampler.numCells(); cell++ ) partials[part].counts[cell] = 0;
+    }
+    pool.run(*this);
+    moves++;
+    samplingNanos += chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+
+    for( int cell=0; cell<sampler.numCells(); cell++ ) counts[cell] = 0;
+    for( int part=0; part<pool.size(); part++ ) {
+	samples += partials[part].samples;
+	for( int cell=0; cell<sampler.numCells(); cell++ ) counts[cell] += partials[part].counts[cell];
+    }
+    int cell = sampler.bestCell(counts);
+    if( cell < 0 ) {
+	return DensityPlayer::getPackedMove();
+    }
+    return PackedMessage( SHOT, cell / boardSize, cell % boardSize, None, 1 );
+}
+
+/**
+ * @brief Draws layouts into the part's own counts until the shot's deadline,
+ * or the part's share of samplesPerMove if that is set.
+ */
+void MonteCarloPlayer::runPart( int part, int parts ) {
+    PartialCounts& mine = partials[part];
+    if( samplesPerMove > 0 ) {
+	int share = samplesPerMove / parts + (part < samplesPerMove % parts ? 1 : 0);
+	for( int i=0; i<share; i++ ) {
+	    if( sampler.draw(mine.rng, mine.counts) ) mine.samples++;
+	}
+	return;
+    }
+    do {
+	for( int i=0; i<DrawsPerCheck; i++ ) {
+	    if( sampler.draw(mine.rng, mine.counts) ) mine.samples++;
+	}
+    } while( chrono::steady_clock::now() < deadline );
+}
+
+void MonteCarloPlayer::updatePacked( PackedMessage msg ) {
+    switch( msg.getMessageType() ) {
+	case MISS:
+	    sampler.miss(msg.getRow(), msg.getCol());
+	    break;
+	case HIT:
+	    sampler.hit(msg.getRow(), msg.getCol());
+	    break;
+	default:	// KILLs come through updateKill()
+	    break;
+    }
+    DensityPlayer::updatePacked(msg);
+}
+
+void MonteCarloPlayer::updateKill( const ShipKill& kill ) {
+    sampler.sunk(kill.cells);
+    DensityPlayer::updateKill(kill);
+}
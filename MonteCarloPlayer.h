@@ -0,0 +1,87 @@
+/**
+ * MonteCarloPlayer.h: a player that shoots where most sampled layouts put a ship.
+ * Date:               October 2026
+ *
+ * For each shot the player draws as many layouts of the opponent's fleet as
+ * fit in its budget of wall-clock time (LayoutSampler) and shoots the cell
+ * most of them cover. A longer budget means better estimates; the default
+ * is DefaultBudgetMicros, and drivers take another with -u. If no layout
+ * could be drawn it shoots like the DensityPlayer it is built on; ships are
+ * placed the same way.
+ *
+ * Given more than one thread (-w), the player draws on all of them at once
+ * through a WorkerPool it makes in its constructor, each thread with its
+ * own random stream and counts, and adds the counts up when the budget is
+ * spent: more layouts in the same time.
+ *
+ * How many layouts fit in the budget depends on how fast the machine is and
+ * how busy, so timed games don't replay from a seed. Given samplesPerMove,
+ * the player instead tries exactly that many draws per shot, each thread a
+ * fixed share of them from its own stream, so its games replay like the
+ * other players' however the threads are scheduled (for the same -w).
+ * Nothing is allocated after the constructor.
+ */
+
+#ifndef MONTECARLOPLAYER_H		// Double inclusion protection
+#define MONTECARLOPLAYER_H
+
+using namespace std;
+
+#include <chrono>
+
+#include "DensityPlayer.h"
+#include "LayoutSampler.h"
+#include "WorkerPool.h"
+#include "Bitboard.h"
+#include "Random.h"
+#include "defines.h"
+
+class MonteCarloPlayer: public DensityPlayer, private ParallelTask {
+    public:
+	static const int DefaultBudgetMicros = 200;
+
+	/**
+	 * @param threads Threads drawing layouts for each shot (see WorkerPool).
+	 * @param samplesPerMove Draws per shot in place of the time budget; 0 = timed.
+	 */
+	MonteCarloPlayer( int boardSize, int budgetMicros = DefaultBudgetMicros, int threads = 1,
+			  int samplesPerMove = 0 );
+	~MonteCarloPlayer();
+	void newRound() override;
+	PackedMessage placePackedShip(int length) override;
+	PackedMessage getPackedMove() override;
+	void updatePacked(PackedMessage msg) override;
+	void updateKill(const ShipKill& kill) override;
+
+	// Sampling so far: layouts drawn, shots taken, and layouts per second of sampling.
+	long long samplesDrawn() const { return samples; }
+	long long movesSampled() const { return moves; }
+	double samplesPerSecond() const;
+	int threads() const { return pool.size(); }
+
+    private:
+	void runPart( int part, int parts ) override;
+
+	// One thread's draws for the current shot.
+	struct PartialCounts {
+	    Random rng;
+	    long long samples;
+	    double counts[Bitboard::Capacity];
+	    char padding[64];	// Keeps the threads off each other's cache lines
+	};
+
+	LayoutSampler sampler;
+	int budgetMicros;
+	int samplesPerMove;	// 0 = draw until the deadline
+	chrono::steady_clock::time_point deadline;	// Of the current shot
+	PartialCounts partials[WorkerPool::MaxThreads];
+	double counts[Bitboard::Capacity];	// Weight of the layouts covering each cell, this shot
+
+	long long samples;
+	long long moves;
+	long long samplingNanos;
+
+	WorkerPool pool;	// Last, so its threads stop before the rest goes
+};
+
+#endif
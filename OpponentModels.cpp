@@ -0,0 +1,341 @@
+/**
+ * OpponentModels.cpp: what learning players know about each opponent, kept in
+ *                     a file that outlives the tournament.
+ * Date:               October 2026
+ */
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "OpponentModels.h"
+
+namespace {
+    const char Magic[4] = { 'B', 'S', 'O', 'M' };
+    const int Version = 1;
+    const size_t HeaderSize = 64;
+    const int NameBytes = 44;	// Longer names are cut short
+    const int ReadTries = 16;	// Reads that lose to commits before giving up
+
+    thread_local const string* currentOpponent = 0;
+
+    uint64_t fnv1a( const void* data, size_t bytes, uint64_t hash = 0xcbf29ce484222325ull ) {
+	const unsigned char* p = (const unsigned char*)data;
+	for( size_t i=0; i<bytes; i++ ) {
+	    hash = (hash ^ p[i]) * 0x100000001b3ull;
+	}
+	return hash;
+    }
+
+    int32_t saturatingAdd( int32_t a, int32_t b ) {
+	int64_t sum = int64_t(a) + b;
+	return sum > INT_MAX ? INT_MAX : sum < INT_MIN ? INT_MIN : int32_t(sum);
+    }
+
+    bool setLock( int fd, short type ) {
+	struct flock lock;
+	memset(&lock, 0, sizeof(lock));
+	lock.l_type = type;
+	lock.l_whence = SEEK_SET;
+	return fcntl(fd, F_OFD_SETLKW, &lock) == 0;
+    }
+
+    /*
+     * Opens the file and waits for a lock (a write lock unless type says
+     * otherwise) on all of it; -1 if that fails.
+     */
+    int lockFile( const string& fileName, int flags, short type = F_WRLCK ) {
+	int fd = ::open(fileName.c_str(), flags, 0644);
+	if( fd >= 0 && !setLock(fd, type) ) {
+	    ::close(fd);
+	    return -1;
+	}
+	return fd;
+    }
+
+    /*
+     * Unlocks before closing: the lock belongs to the open file, which a
+     * mapping made through fd keeps open.
+     */
+    void unlockFile( int fd ) {
+	setLock(fd, F_UNLCK);
+	::close(fd);
+    }
+
+    /*
+     * Writes the mapped bytes at start to the disk before returning.
+     */
+    void syncToDisk( const void* start, size_t bytes ) {
+	static const uintptr_t PageSize = sysconf(_SC_PAGESIZE);
+	uintptr_t first = uintptr_t(start) & ~(PageSize-1);
+	msync((void*)first, uintptr_t(start) + bytes - first, MS_SYNC);
+    }
+}
+
+struct ModelSlot {
+    uint64_t generation;
+    uint64_t checksum;		// Of model
+    OpponentModel model;
+};
+
+struct ModelRecord {
+    atomic<uint64_t> key;	// 0 = free; set last when a record is made
+    atomic<uint64_t> current;	// Generation of the latest commit, in slots[current & 1]; 0 = none
+    int32_t boardSize;
+    char opponent[NameBytes];
+    ModelSlot slots[2];
+
+    bool holds( uint64_t key, const string& opponent, int boardSize ) const {
+	return this->key.load(memory_order_acquire) == key && this->boardSize == boardSize &&
+	       strncmp(this->opponent, opponent.c_str(), NameBytes-1) == 0;
+    }
+
+    /*
+     * Copies the latest intact model: the current slot, or the one before
+     * if it is damaged. Without a lock a commit may overwrite the slot as it
+     * is copied; then the generation has moved and it tries again. But a
+     * commit refilling the slot before hasn't moved it yet, so false is
+     * only certain under a lock (see OpponentModels::read()).
+     */
+    bool latest( OpponentModel& model ) const {
+	for( int tries=0; tries<ReadTries; tries++ ) {
+	    uint64_t generation = current.load(memory_order_acquire);
+	    if( generation == 0 ) return false;
+	    for( uint64_t g=generation; g>0 && g+2>generation; g-- ) {
+		const ModelSlot& slot = slots[g & 1];
+		uint64_t slotGeneration = slot.generation;
+		uint64_t checksum = slot.checksum;
+		memcpy(&model, &slot.model, sizeof(model));
+		atomic_thread_fence(memory_order_acquire);
+		if( current.load(memory_order_relaxed) != generation ) break;	// Try again
+		if( slotGeneration == g && checksum == fnv1a(&model, sizeof(model)) ) return true;
+	    }
+	    if( current.load(memory_order_relaxed) == generation ) return false;	// Both slots bad
+	}
+	return false;
+    }
+};
+
+void OpponentModel::clear() {
+    memset(this, 0, sizeof(*this));
+}
+
+OpponentModels::OpponentModels() {
+    mapping = 0;
+    mappedBytes = 0;
+    records = 0;
+    capacity = 0;
+}
+
+OpponentModels::~OpponentModels() {
+    close();
+}
+
+OpponentModels& OpponentModels::shared() {
+    static OpponentModels store;
+    return store;
+}
+
+void OpponentModels::setOpponent( const string* name ) {
+    currentOpponent = name;
+}
+
+const string& OpponentModels::opponent() {
+    static const string none;
+    return currentOpponent ? *currentOpponent : none;
+}
+
+bool OpponentModels::open( const string& fileName ) {
+    close();
+    // The lock makes sure only one process lays out a new file.
+    int fd = lockFile(fileName, O_RDWR | O_CREAT);
+    if( fd < 0 ) {
+	problem = "can't open and lock " + fileName;
+	return false;
+    }
+    struct stat info;
+    bool ok = fstat(fd, &info) == 0;
+    if( ok && info.st_size == 0 ) {
+	unsigned char header[HeaderSize] = { 0 };
+	uint32_t newCapacity = Capacity, recordBytes = sizeof(ModelRecord);
+	memcpy(header, Magic, 4);
+	header[4] = Version;
+	memcpy(header + 8, &newCapacity, 4);
+	memcpy(header + 12, &recordBytes, 4);
+	ok = ftruncate(fd, HeaderSize + size_t(Capacity)*sizeof(ModelRecord)) == 0 &&
+	     pwrite(fd, header, HeaderSize, 0) == ssize_t(HeaderSize) && fstat(fd, &info) == 0;
+    }
+    void* memory = MAP_FAILED;
+    if( ok && size_t(info.st_size) >= HeaderSize ) {
+	memory = mmap(0, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    unlockFile(fd);
+    if( memory == MAP_FAILED ) {
+	problem = fileName + " is not a model store";
+	return false;
+    }
+
+    const unsigned char* header = (const unsigned char*)memory;
+    uint32_t fileCapacity, recordBytes;
+    memcpy(&fileCapacity, header + 8, 4);
+    memcpy(&recordBytes, header + 12, 4);
+    if( memcmp(header, Magic, 4) != 0 ) {
+	problem = fileName + " is not a model store";
+    } else if( header[4] != Version ) {
+	problem = fileName + " is a version " + to_string(header[4]) + " model store, expected "
+		  + to_string(Version);
+    } else if( recordBytes != sizeof(ModelRecord) || fileCapacity == 0 || (fileCapacity & (fileCapacity-1)) != 0
+	       || size_t(info.st_size) != HeaderSize + size_t(fileCapacity)*recordBytes ) {
+	problem = fileName + " is damaged or from another build";
+    }
+    if( !problem.empty() ) {
+	munmap(memory, info.st_size);
+	return false;
+    }
+    this->fileName = fileName;
+    mapping = memory;
+    mappedBytes = info.st_size;
+    records = (ModelRecord*)((unsigned char*)memory + HeaderSize);
+    capacity = fileCapacity;
+    return true;
+}
+
+void OpponentModels::close() {
+    if( mapping ) munmap(mapping, mappedBytes);
+    mapping = 0;
+    mappedBytes = 0;
+    records = 0;
+    capacity = 0;
+    problem = "";
+}
+
+namespace {
+    uint64_t modelKey( const string& opponent, int boardSize ) {
+	string name = opponent.substr(0, NameBytes-1);
+	uint64_t key = fnv1a(name.data(), name.size()) ^ uint64_t(boardSize) * 0x9E3779B97F4A7C15ull;
+	return key ? key : 1;
+    }
+}
+
+/*
+ * The record of the model, or the free record that would hold it, or 0
+ * if the table is full.
+ */
+ModelRecord* OpponentModels::find( uint64_t key, const string& opponent, int boardSize ) const {
+    uint32_t home = (key >> 32) & (capacity-1);
+    for( uint32_t i=0; i<capacity; i++ ) {
+	ModelRecord* record = &records[(home + i) & (capacity-1)];
+	if( record->key.load(memory_order_acquire) == 0 || record->holds(key, opponent, boardSize) ) return record;
+    }
+    return 0;
+}
+
+bool OpponentModels::read( const string& opponent, int boardSize, OpponentModel& model ) const {
+    if( records ) {
+	ModelRecord* record = find(modelKey(opponent, boardSize), opponent, boardSize);
+	if( record && record->key.load(memory_order_acquire) != 0 ) {
+	    if( record->latest(model) ) return true;
+	    int fd = lockFile(fileName, O_RDONLY, F_RDLCK);
+	    if( fd >= 0 ) {
+		bool found = record->latest(model);	// Nothing moves now
+		unlockFile(fd);
+		if( found ) return true;
+	    }
+	}
+    }
+    model.clear();
+    return false;
+}
+
+bool OpponentModels::add( const string& opponent, int boardSize, const OpponentModel& delta ) {
+    if( !records ) return false;
+    int fd = lockFile(fileName, O_RDWR);
+    if( fd < 0 ) {
+	problem = "can't lock " + fileName;
+	return false;
+    }
+    uint64_t key = modelKey(opponent, boardSize);
+    ModelRecord* record = find(key, opponent, boardSize);
+    if( !record ) {
+	unlockFile(fd);
+	problem = fileName + " is full";
+	return false;
+    }
+    if( record->key.load(memory_order_acquire) == 0 ) {
+	// Filled in before the key, which readers look for first.
+	record->current.store(0, memory_order_relaxed);
+	record->boardSize = boardSize;
+	memset(record->opponent, 0, NameBytes);
+	strncpy(record->opponent, opponent.c_str(), NameBytes-1);
+	syncToDisk(record, sizeof(*record));
+	record->key.store(key, memory_order_release);
+    }
+
+    // Nobody else commits while we hold the lock.
+    OpponentModel sum;
+    if( !record->latest(sum) ) sum.clear();
+    sum.rounds = saturatingAdd(sum.rounds, delta.rounds);
+    for( int cell=0; cell<OpponentModel::MaxCells; cell++ ) {
+	sum.heat[cell] = saturatingAdd(sum.heat[cell], delta.heat[cell]);
+	sum.shots[cell] = saturatingAdd(sum.shots[cell], delta.shots[cell]);
+    }
+    uint64_t generation = record->current.load(memory_order_relaxed) + 1;
+    ModelSlot& slot = record->slots[generation & 1];
+    slot.generation = generation;
+    slot.model = sum;
+    slot.checksum = fnv1a(&sum, sizeof(sum));
+    syncToDisk(&slot, sizeof(slot));
+    record->current.store(generation, memory_order_release);	// The commit
+    unlockFile(fd);
+    return true;
+}
+
+OpponentMemory::OpponentMemory( int boardSize ) {
+    this->boardSize = boardSize;
+    this->enabled = OpponentModels::shared().isOpen() && !OpponentModels::opponent().empty()
+		    && boardSize <= MAX_BOARD_SIZE;
+    if( enabled ) this->opponent = OpponentModels::opponent();
+    this->pendingRounds = 0;
+    base.clear();
+    now.clear();
+}
+
+bool OpponentMemory::warmStart() {
+    if( !enabled || !OpponentModels::shared().read(opponent, boardSize, base) ) {
+	base.clear();
+	now.clear();
+	return false;
+    }
+    if( base.rounds > WarmRounds ) {
+	for( int cell=0; cell<OpponentModel::MaxCells; cell++ ) {
+	    base.heat[cell] = int64_t(base.heat[cell]) * WarmRounds / base.rounds;
+	    base.shots[cell] = int64_t(base.shots[cell]) * WarmRounds / base.rounds;
+	}
+	base.rounds = WarmRounds;
+    }
+    now = base;
+    return true;
+}
+
+void OpponentMemory::commit() {
+    if( !enabled || pendingRounds == 0 ) return;
+    OpponentModel delta;
+    delta.rounds = pendingRounds;
+    for( int cell=0; cell<OpponentModel::MaxCells; cell++ ) {
+	delta.heat[cell] = now.heat[cell] - base.heat[cell];
+	delta.shots[cell] = now.shots[cell] - base.shots[cell];
+    }
+    if( !OpponentModels::shared().add(opponent, boardSize, delta) ) {
+	static atomic<bool> warned(false);
+	if( !warned.exchange(true) ) {
+	    cerr << "Opponent models: " << OpponentModels::shared().error() << ", not saved" << endl;
+	}
+    }
+    base = now;
+    pendingRounds = 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * OpponentModels.h: what learning players know about each opponent, kept in
+ *                   a file that outlives the tournament.
+ * Date:             October 2026
+ *
+ * Deng and Lewis learn where an opponent puts its ships (HeatMapHunt's heat
+ * map) and Lewis where it shoots (oppShot), but each new player object
+ * used to start from nothing. With --models FILE, the drivers open FILE as
+ * the process's OpponentModels::shared() store. A learning player then
+ * starts from the stored model of its opponent, and adds what it learns
+ * back to it (OpponentMemory). Without --models nothing changes, and games
+ * replay from their seed as before.
+ *
+ * Models are keyed by (opponent name, board size), for boards up to
+ * MAX_BOARD_SIZE; the name, not the player number, since the numbers
+ * differ between contest and testAI. MatchRunner tells each thread the
+ * opponent of the player it is about to make (setOpponent()), as it seeds
+ * the thread's random stream, so a player knows it in its constructor.
+ *
+ * The file is mapped shared, so every process using it (concurrent
+ * tournaments, sandboxed players) sees the same models:
+ *
+ *   header    "BSOM" version(1) 0 0 0, capacity(4), recordBytes(4), zeros to 64 bytes
+ *   records   capacity x ModelRecord, an open addressed hash table
+ *
+ * Each record holds two copies (slots) of its model. A commit, under a
+ * write lock on the file (an open file description lock, so it excludes
+ * threads and processes alike and goes away with a process that dies),
+ * adds what a player learnt to the latest copy. It writes the sum, with
+ * its generation and a checksum, into the other slot. Only then does it
+ * advance the record's current generation. Readers take no lock: they copy
+ * the current slot and keep it only if the generation didn't move meanwhile
+ * and the checksum holds, else they try again. One that keeps failing, as
+ * it may while a commit refills the other slot, reads once more under a
+ * read lock, where no commit is half done.
+ *
+ * A process that dies mid-commit leaves the previous copy current. Against
+ * a power cut, a commit msync()s its slot before advancing the generation,
+ * so the generation on disk never points at a slot that isn't there. The
+ * last commits before the cut may be lost. A slot damaged anyway fails its
+ * checksum, and the previous copy is read instead; if that fails too, the
+ * player starts without a model.
+ */
+
+#ifndef OPPONENTMODELS_H		// Double inclusion protection
+#define OPPONENTMODELS_H
+
+#include <stdint.h>
+#include <string>
+
+#include "defines.h"
+
+using namespace std;
+
+/**
+ * @brief A model of one opponent on one board size; cells are row*boardSize+col.
+ */
+struct OpponentModel {
+    static const int MaxCells = MAX_BOARD_SIZE*MAX_BOARD_SIZE;
+
+    void clear();
+
+    int32_t rounds;		// Rounds the tables were learnt from
+    int32_t heat[MaxCells];	// Hits on the opponent's ships
+    int32_t shots[MaxCells];	// The opponent's shots, each worth boardSize^2 minus the shots before it (as Lewis counts)
+};
+
+struct ModelRecord;
+
+class OpponentModels {
+    public:
+	static const int Capacity = 1024;	// Records in a new file
+
+	OpponentModels();
+	~OpponentModels();
+
+	/**
+	 * @brief The store the drivers open for --models; not open otherwise.
+	 */
+	static OpponentModels& shared();
+
+	/**
+	 * @brief The opponent of the next player made on this thread; empty if
+	 * none was set. The name must outlive the player's constructor. Players
+	 * made in a sandbox inherit it through fork().
+	 */
+	static void setOpponent( const string* name );
+	static const string& opponent();
+
+	/**
+	 * @brief Maps the file, making it if there is none.
+	 * @return false (with error() saying why) if it isn't a model store.
+	 */
+	bool open( const string& fileName );
+	void close();
+	bool isOpen() const { return records != 0; }
+	const string& error() const { return problem; }
+
+	/**
+	 * @brief The latest committed model; false (and model cleared) if there is none.
+	 */
+	bool read( const string& opponent, int boardSize, OpponentModel& model ) const;
+
+	/**
+	 * @brief Adds delta's rounds and tables to the stored model, atomically.
+	 * @return false if the file is full or can't be locked.
+	 */
+	bool add( const string& opponent, int boardSize, const OpponentModel& delta );
+
+    private:
+	OpponentModels( const OpponentModels& );
+	void operator=( const OpponentModels& );
+
+	ModelRecord* find( uint64_t key, const string& opponent, int boardSize ) const;
+
+	string fileName;
+	void* mapping;
+	size_t mappedBytes;
+	ModelRecord* records;	// Into mapping; 0 if no store is open
+	uint32_t capacity;
+	string problem;
+};
+
+/**
+ * @brief A learning player's link to the shared model of its opponent.
+ *
+ * Made in the player's constructor. If the store is open and the opponent
+ * known, warmStart() gives the stored model, scaled down to at most
+ * WarmRounds rounds, so a change of the opponent's habits soon shows
+ * through. The player calls roundStarted() from newRound(). When due(), and
+ * in its destructor, it writes the tables it learns into tables(), warm
+ * start included, and calls commit(). commit() adds the difference since
+ * the last commit to the store.
+ */
+class OpponentMemory {
+    public:
+	static const int CommitRounds = 100;
+	static const int WarmRounds = 200;
+
+	OpponentMemory( int boardSize );
+
+	bool active() const { return enabled; }
+
+	/**
+	 * @brief Loads the stored model, scaled, into tables().
+	 * @return false (tables() cleared) if there is none.
+	 */
+	bool warmStart();
+
+	void roundStarted() { if( enabled ) pendingRounds++; }
+	bool due() const { return enabled && pendingRounds >= CommitRounds; }
+
+	// The tables for commit(), rounds aside: as last committed (or warm
+	// started) until the player writes the ones it learns over them.
+	OpponentModel& tables() { return now; }
+	void commit();
+
+    private:
+	bool enabled;
+	int boardSize;
+	string opponent;
+	int pendingRounds;
+	OpponentModel base;	// What the store has had from us (or gave us)
+	OpponentModel now;
+};
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * Options.cpp: command line and config file settings for contest and testAI.
+ * Date:        October 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+#include <getopt.h>
+
+#include "Options.h"
+
+using namespace std;
+
+RunOptions::RunOptions() {
+    boardSize = 0;
+    rounds = 0;
+    secondsPerMove = -1;
+    display = true;
+    showAllRounds = false;
+    askShowAllRounds = true;
+    threads = 1;
+    blockSize = 0;
+    seed = 0;
+    haveSeed = false;
+    haveThreads = false;
+    format = TextOutput;
+    replayPairing = 0;
+    replayRound = -1;
+    timing = false;
+    confidence = 0;
+    margin = 0.05;
+    targetDeviation = 50;
+    sandbox = false;
+    deadlineMillis = 1000;
+    memoryMegabytes = 256;
+    moveBudgetMicros = 200;
+    moveThreads = 1;
+    moveSamples = 0;
+}
+
+namespace {
+    string trim( const string& str ) {
+	size_t first = str.find_first_not_of(" \t\r\n");
+	if( first == string::npos ) return "";
+	size_t last = str.find_last_not_of(" \t\r\n");
+	return str.substr(first, last-first+1);
+    }
+
+    // Lower case, without spaces, dashes and underscores: "Semi-Smart Player" -> "semismartplayer"
+    string simplify( const string& str ) {
+	string result;
+	for( size_t i=0; i<str.size(); i++ ) {
+	    if( isalnum((unsigned char)str[i]) ) result += tolower((unsigned char)str[i]);
+	}
+	return result;
+    }
+
+    bool parseInt( const string& value, int& result ) {
+	char* end;
+	long number = strtol(value.c_str(), &end, 10);
+	if( value.empty() || *end != '\0' ) return false;
+	result = number;
+	return true;
+    }
+
+    bool parseBool( const string& value, bool& result ) {
+	string v = simplify(value);
+	if( v == "yes" || v == "y" || v == "true" || v == "on" || v == "1" ) result = true;
+	else if( v == "no" || v == "n" || v == "false" || v == "off" || v == "0" ) result = false;
+	else return false;
+	return true;
+    }
+
+    bool readConfig( const string& fileName, RunOptions& options );
+
+    /*
+     * Applies one setting. The names are the long option names.
+     */
+    bool applySetting( const string& name, const string& value, RunOptions& options ) {
+	bool ok = true;
+	if( name == "board" ) {
+	    ok = parseInt(value, options.boardSize);
+	} else if( name == "rounds" ) {
+	    ok = parseInt(value, options.rounds);
+	} else if( name == "delay" ) {
+	    char* end;
+	    options.secondsPerMove = strtof(value.c_str(), &end);
+	    ok = !value.empty() && *end == '\0';
+	} else if( name == "seed" ) {
+	    char* end;
+	    options.seed = strtoul(value.c_str(), &end, 10);
+	    options.haveSeed = ok = !value.empty() && *end == '\0';
+	} else if( name == "threads" ) {
+	    options.haveThreads = ok = parseInt(value, options.threads);
+	} else if( name == "block" ) {
+	    ok = parseInt(value, options.blockSize);
+	} else if( name == "players" ) {
+	    options.players.clear();
+	    stringstream list(value);
+	    string player;
+	    while( getline(list, player, ',') ) {
+		if( !trim(player).empty() ) options.players.push_back(trim(player));
+	    }
+	} else if( name == "format" ) {
+	    string v = simplify(value);
+	    if( v == "text" ) options.format = TextOutput;
+	    else if( v == "csv" ) options.format = CsvOutput;
+	    else if( v == "json" ) options.format = JsonOutput;
+	    else ok = false;
+	} else if( name == "game" ) {
+	    size_t colon = value.find(':');
+	    options.replayPairing = 0;
+	    ok = colon == string::npos ? parseInt(value, options.replayRound)
+		 : parseInt(value.substr(0, colon), options.replayPairing) &&
+		   parseInt(value.substr(colon+1), options.replayRound);
+	    ok = ok && options.replayPairing >= 0 && options.replayRound >= 0;
+	} else if( name == "timing" ) {
+	    ok = parseBool(value, options.timing);
+	} else if( name == "timing-csv" ) {
+	    options.timingCsv = value;
+	    options.timing = ok = !value.empty();
+	} else if( name == "log" ) {
+	    options.logFile = value;
+	    ok = !value.empty();
+	} else if( name == "confidence" ) {
+	    char* end;
+	    options.confidence = strtod(value.c_str(), &end);
+	    ok = !value.empty() && *end == '\0' && (options.confidence == 0 ||
+		 (options.confidence > 0.5 && options.confidence < 1));
+	} else if( name == "margin" ) {
+	    char* end;
+	    options.margin = strtod(value.c_str(), &end);
+	    ok = !value.empty() && *end == '\0' && options.margin > 0 && options.margin < 0.5;
+	} else if( name == "ratings" ) {
+	    options.ratingsFile = value;
+	    ok = !value.empty();
+	} else if( name == "deviation" ) {
+	    char* end;
+	    options.targetDeviation = strtod(value.c_str(), &end);
+	    ok = !value.empty() && *end == '\0' && options.targetDeviation > 0;
+	} else if( name == "sandbox" ) {
+	    ok = parseBool(value, options.sandbox);
+	} else if( name == "deadline" ) {
+	    ok = parseInt(value, options.deadlineMillis) && options.deadlineMillis > 0;
+	} else if( name == "memory" ) {
+	    ok = parseInt(value, options.memoryMegabytes) && options.memoryMegabytes > 0;
+	} else if( name == "budget" ) {
+	    ok = parseInt(value, options.moveBudgetMicros) && options.moveBudgetMicros > 0;
+	} else if( name == "workers" ) {
+	    ok = parseInt(value, options.moveThreads) && options.moveThreads >= 0;
+	} else if( name == "samples" ) {
+	    ok = parseInt(value, options.moveSamples) && options.moveSamples > 0;
+	} else if( name == "models" ) {
+	    options.modelFile = value;
+	    ok = !value.empty();
+	} else if( name == "plugins" ) {
+	    options.pluginDir = value;
+	    ok = !value.empty();
+	} else if( name == "display" ) {
+	    ok = parseBool(value, options.display);
+	} else if( name == "all-rounds" ) {
+	    ok = parseBool(value, options.showAllRounds);
+	    options.askShowAllRounds = false;
+	} else if( name == "config" ) {
+	    return readConfig(value, options);
+	} else {
+	    cerr << "Unknown setting '" << name << "'" << endl;
+	    return false;
+	}
+	if( !ok ) {
+	    cerr << "Bad value '" << value << "' for " << name << endl;
+	}
+	return ok;
+    }
+
+    // The config files being read, outermost first, by real path: a file
+    // that names itself, directly or through another, is an error.
+    vector<string> configsOpen;
+
+    bool readConfigLines( const string& fileName, RunOptions& options );
+
+    bool readConfig( const string& fileName, RunOptions& options ) {
+	char* resolved = realpath(fileName.c_str(), 0);
+	string path = resolved ? resolved : fileName;
+	free(resolved);
+	if( find(configsOpen.begin(), configsOpen.end(), path) != configsOpen.end() ) {
+	    cerr << "Config file " << fileName << " reads itself" << endl;
+	    return false;
+	}
+	configsOpen.push_back(path);
+	bool ok = readConfigLines(fileName, options);
+	configsOpen.pop_back();
+	return ok;
+    }
+
+    bool readConfigLines( const string& fileName, RunOptions& options ) {
+	ifstream config(fileName.c_str());
+	if( !config ) {
+	    cerr << "Can't open config file " << fileName << endl;
+	    return false;
+	}
+	string line;
+	int lineNumber = 0;
+	while( getline(config, line) ) {
+	    lineNumber++;
+	    line = trim(line.substr(0, line.find('#')));
+	    if( line.empty() ) continue;
+	    size_t equals = line.find('=');
+	    if( equals == string::npos ) {
+		cerr << fileName << ":" << lineNumber << ": expected name = value" << endl;
+		return false;
+	    }
+	    if( !applySetting(trim(line.substr(0, equals)), trim(line.substr(equals+1)), options) ) {
+		cerr << fileName << ":" << lineNumber << ": bad setting" << endl;
+		return false;
+	    }
+	}
+	return true;
+    }
+}
+
+bool parseOptions( int argc, char* argv[], RunOptions& options ) {
+    static const struct option longOptions[] = {
+	{ "board",      required_argument, 0, 'n' },
+	{ "rounds",     required_argument, 0, 'r' },
+	{ "delay",      required_argument, 0, 'd' },
+	{ "seed",       required_argument, 0, 's' },
+	{ "threads",    required_argument, 0, 'j' },
+	{ "block",      required_argument, 0, 'b' },
+	{ "players",    required_argument, 0, 'p' },
+	{ "format",     required_argument, 0, 'f' },
+	{ "game",       required_argument, 0, 'g' },
+	{ "log",        required_argument, 0, 'l' },
+	{ "timing-csv", required_argument, 0, 'T' },
+	{ "timing",     no_argument,       0, 't' },
+	{ "confidence", required_argument, 0, 'C' },
+	{ "margin",     required_argument, 0, 'm' },
+	{ "ratings",    required_argument, 0, 'R' },
+	{ "deviation",  required_argument, 0, 'D' },
+	{ "sandbox",    no_argument,       0, 'S' },
+	{ "deadline",   required_argument, 0, 'M' },
+	{ "memory",     required_argument, 0, 'B' },
+	{ "budget",     required_argument, 0, 'u' },
+	{ "workers",    required_argument, 0, 'w' },
+	{ "samples",    required_argument, 0, 'U' },
+	{ "models",     required_argument, 0, 'O' },
+	{ "plugins",    required_argument, 0, 'P' },
+	{ "config",     required_argument, 0, 'c' },
+	{ "no-display", no_argument,       0, 'q' },
+	{ "all-rounds", no_argument,       0, 'a' },
+	{ "help",       no_argument,       0, 'h' },
+	{ 0, 0, 0, 0 }
+    };
+
+    int opt, index;
+    while( (opt = getopt_long(argc, argv, "n:r:d:s:j:b:p:f:g:l:T:C:m:R:D:M:B:u:w:U:O:P:c:tSqah", longOptions, &index)) != -1 ) {
+	bool ok = true;
+	switch( opt ) {
+	    case 'q': options.display = false; break;
+	    case 'a': options.showAllRounds = true; options.askShowAllRounds = false; break;
+	    case 't': options.timing = true; break;
+	    case 'S': options.sandbox = true; break;
+	    case 'h': printUsage(argv[0]); return false;
+	    case '?': printUsage(argv[0]); return false;
+	    default:
+		for( index=0; longOptions[index].name; index++ ) {
+		    if( longOptions[index].val == opt ) break;
+		}
+		ok = applySetting(longOptions[index].name, optarg, options);
+	}
+	if( !ok ) return false;
+    }
+    if( optind < argc ) {
+	cerr << "Unexpected argument '" << argv[optind] << "'" << endl;
+	printUsage(argv[0]);
+	return false;
+    }
+    if( options.threads < 1 ) options.threads = 1;
+    if( options.sandbox && options.threads > 1 ) {
+	// A child forked from one of several threads can inherit a lock
+	// another thread held, and hang on it.
+	cerr << "--sandbox plays on one thread; it can't be used with --threads " << options.threads << endl;
+	return false;
+    }
+    if( options.moveSamples == 0 && (options.haveSeed || options.replayRound >= 0 || options.haveThreads) ) {
+	// The clock would pick the Monte Carlo Player's shots.
+	options.moveSamples = options.moveBudgetMicros * RunOptions::SamplesPerMicro;
+    }
+    return true;
+}
+
+int findPlayer( const string& name, const string playerNames[], int numPlayers ) {
+    int number;
+    if( parseInt(name, number) ) {
+	return number >= 0 && number < numPlayers ? number : -1;
+    }
+    // An exact name wins; otherwise accept a prefix that only one player has.
+    int found = -1;
+    string wanted = simplify(name);
+    for( int i=0; i<numPlayers; i++ ) {
+	string candidate = simplify(playerNames[i]);
+	if( candidate == wanted ) return i;
+	if( !wanted.empty() && candidate.compare(0, wanted.size(), wanted) == 0 ) {
+	    found = found == -1 ? i : -2;
+	}
+    }
+    return found < 0 ? -1 : found;
+}
+
+string jsonString( const string& str ) {
+    static const char hex[] = "0123456789abcdef";
+    string quoted = "\"";
+    for( size_t i=0; i<str.size(); i++ ) {
+	unsigned char c = str[i];
+	if( c == '"' || c == '\\' ) {
+	    quoted += '\\';
+	    quoted += c;
+	} else if( c < 0x20 ) {
+	    quoted += "\\u00";
+	    quoted += hex[c >> 4];
+	    quoted += hex[c & 15];
+	} else {
+	    quoted += c;
+	}
+    }
+    return quoted + "\"";
+}
+
+void printUsage( const char* program ) {
+    cerr << "Usage: " << program << " [options]" << endl
+	 << "  -n, --board N         board size (3-128)" << endl
+	 << "  -r, --rounds N        rounds per match" << endl
+	 << "  -d, --delay SECONDS   seconds per move in displayed rounds" << endl
+	 << "  -s, --seed N          tournament seed (default: the clock)" << endl
+	 << "  -p, --players A,B,..  players by name or number" << endl
+	 << "  -f, --format F        text, csv or json results" << endl
+	 << "  -q, --no-display      don't show games or pause" << endl
+	 << "  -a, --all-rounds      testAI: show every round" << endl
+	 << "  -j, --threads N       play on N threads (headless)" << endl
+	 << "  -b, --block N         new player objects every N rounds" << endl
+	 << "  -g, --game [P:]R      replay round R of pairing P (same seed/block)" << endl
+	 << "  -l, --log FILE        record every game in FILE (see ./replay)" << endl
+	 << "  -t, --timing          print p50/p99/max of the players' calls per match" << endl
+	 << "  -T, --timing-csv FILE write the call latency histograms to FILE" << endl
+	 << "  -C, --confidence P    stop a match once decided at confidence P (e.g. 0.95)" << endl
+	 << "  -m, --margin D        win rate difference from 50% to look for (default 0.05)" << endl
+	 << "  -R, --ratings FILE    contest: rated matches, keeping the ratings in FILE" << endl
+	 << "  -D, --deviation D     rate until every deviation is at most D (default 50)" << endl
+	 << "  -S, --sandbox         run each player in its own process" << endl
+	 << "  -M, --deadline MS     sandbox: ms per move before a player forfeits (default 1000)" << endl
+	 << "  -B, --memory MB       sandbox: memory a player may add (default 256)" << endl
+	 << "  -u, --budget US       Monte Carlo Player: us of sampling per shot (default 200)" << endl
+	 << "  -w, --workers N       Monte Carlo Player: threads sampling each shot (0: per CPU)" << endl
+	 << "  -U, --samples N       Monte Carlo Player: N layouts per shot, not timed (default" << endl
+	 << "                        with -s, -g or -j: 4 per us of budget)" << endl
+	 << "  -O, --models FILE     Deng, Lewis: keep what they learn of each opponent in FILE" << endl
+	 << "  -P, --plugins DIR     load player plugins from DIR (default ./plugins)" << endl
+	 << "  -c, --config FILE     read settings from FILE" << endl
+	 << "Anything not given is asked for." << endl;
+}
@@ -0,0 +1,145 @@
+/**
+ * Options.h: command line and config file settings for contest and testAI.
+ * Date:      October 2026
+ *
+ * Anything not given on the command line or in a config file is asked for
+ * interactively, as before. With everything given (and --no-display) the
+ * programs run without prompts or pauses, e.g.
+ *
+ *   ./testAI --board 10 --rounds 100000 --players Deng,Lewis --no-display --format csv
+ *
+ * A config file holds the same settings, one "name = value" per line,
+ * using the long option names without dashes; '#' starts a comment:
+ *
+ *   board = 10
+ *   rounds = 100000
+ *   players = Gambler Player, Clean Player
+ *   display = no
+ *
+ * Later settings override earlier ones, so command line options after
+ * --config override the file. A config file may read another with
+ * "config = FILE", but not itself, directly or through others.
+ *
+ * Every game has an id, PAIRING:ROUND, printed after its result. With the
+ * run's seed, board, players and block size, --game replays just that game:
+ *
+ *   ./contest --seed 42 --board 10 --rounds 500 --game 3:217
+ *
+ * --timing prints how long each player's calls take after every match;
+ * --timing-csv FILE also writes the latency histograms to FILE.
+ *
+ * --log FILE records every game in a binary log that ./replay can show or
+ * check without the players.
+ *
+ * --confidence C stops each match as soon as it is decided at confidence C
+ * (see SequentialTest.h); --margin sets the smallest win rate difference
+ * from 50% worth finding. contest then plays the rounds the decided matches
+ * saved in the matches still undecided, in blocks of fresh players after
+ * their --rounds; --game can't replay those extra rounds.
+ *
+ * contest --ratings FILE plays rated matches instead of the lives
+ * tournament (see Ratings.h): always the match that teaches the most, until
+ * every entrant's rating deviation is at most --deviation, then saves FILE
+ * and prints the leaderboard.
+ *
+ * --sandbox runs every player in a process of its own (see Sandbox.h): a
+ * player that takes more than --deadline ms for a move, crashes or uses
+ * more than --memory MB more than it started with forfeits the game
+ * instead of taking the tournament down. It can't be combined with
+ * --threads above 1: the children are forked, and a fork from one of
+ * several threads may inherit a lock another thread held.
+ *
+ * --budget US gives the Monte Carlo Player US microseconds of sampling for
+ * each shot, and --workers N has it sample on N threads at once (0: one per
+ * CPU; see MonteCarloPlayer.h). How many layouts fit in that time depends on
+ * the machine, so with --seed, --game or --threads it draws a fixed number
+ * instead, SamplesPerMicro per microsecond of budget, for games that replay;
+ * --samples N sets the number itself.
+ *
+ * --models FILE keeps what Deng and Lewis learn about each opponent in FILE,
+ * and starts them from it (see OpponentModels.h). Tournaments may share FILE,
+ * even at the same time.
+ *
+ * --plugins DIR loads the players in DIR's shared libraries after the
+ * built-in ones (see Plugins.h); without it, ./plugins is used if it exists.
+ */
+
+#ifndef OPTIONS_H		// Double inclusion protection
+#define OPTIONS_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum OutputFormat { TextOutput, CsvOutput, JsonOutput };
+
+struct RunOptions {
+    static const int SamplesPerMicro = 4;	// Of --budget, when drawing a fixed number; about one core's rate
+
+    RunOptions();
+
+    int boardSize;		// 0 = ask
+    int rounds;			// 0 = ask
+    float secondsPerMove;	// < 0 = ask
+    bool display;		// Show games and pause between matches
+    bool showAllRounds;		// testAI: show every round, not just the last
+    bool askShowAllRounds;	// testAI: nobody said, so ask
+    int threads;
+    int blockSize;
+    unsigned int seed;
+    bool haveSeed;
+    bool haveThreads;		// --threads was given, so runs will be compared
+    vector<string> players;	// Names or numbers; empty = ask / everybody
+    OutputFormat format;
+    int replayPairing;		// --game PAIRING:ROUND (pairing 0 if only ROUND)
+    int replayRound;		// -1 = no replay
+    bool timing;		// Time the players' calls and print p50/p99/max per match
+    string timingCsv;		// Also dump the latency histograms here; empty = don't
+    string logFile;		// Record every game here (see GameLog.h); empty = don't
+    double confidence;		// Stop matches once decided at this confidence; 0 = play every round
+    double margin;		// Win rate difference from 1/2 the sequential test looks for
+
+    string ratingsFile;		// contest: rated matches, with the ratings kept here; empty = lives tournament
+    double targetDeviation;	// Rate until every entrant's deviation is at most this
+    bool sandbox;		// Every player in a process of its own
+    int deadlineMillis;		// Sandbox: longest move or placement
+    int memoryMegabytes;	// Sandbox: memory a player may add
+    int moveBudgetMicros;	// Monte Carlo Player: sampling time per shot
+    int moveThreads;		// Monte Carlo Player: threads sampling each shot; 0 = one per CPU
+    int moveSamples;		// Monte Carlo Player: layouts drawn per shot; 0 = for moveBudgetMicros
+    string modelFile;		// Opponent models shared across tournaments; empty = none
+    string pluginDir;		// Player plugins; empty = ./plugins, if there is one
+
+    bool sequential() const { return confidence > 0; }
+
+    // True if every game is played without any screen output.
+    bool headless() const { return !display || threads > 1 || format != TextOutput || sequential() ||
+				    !ratingsFile.empty(); }
+};
+
+/**
+ * @brief Parses argv into options, reading any --config files on the way.
+ * @return false (after printing why) if the arguments are bad.
+ */
+bool parseOptions( int argc, char* argv[], RunOptions& options );
+
+/**
+ * @brief Finds a player by number or by name (case, spaces and dashes ignored).
+ * A prefix is enough if only one player's name starts with it ("semi").
+ * @return The player's index, or -1 if there is no such player.
+ */
+int findPlayer( const string& name, const string playerNames[], int numPlayers );
+
+/**
+ * @brief str as a JSON string literal, quotes included, for --format json.
+ * Player names can be anything a plugin says, so they go through here.
+ */
+string jsonString( const string& str );
+
+/**
+ * @brief Prints the option summary.
+ */
+void printUsage( const char* program );
+
+#endif
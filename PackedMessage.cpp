@@ -0,0 +1,60 @@
+/**
+ * PackedMessage.cpp: packed messages and the label table.
+ * Date:              October 2026
+ */
+
+#include <mutex>
+#include <atomic>
+#include <type_traits>
+
+#include "PackedMessage.h"
+
+using namespace std;
+
+static_assert(sizeof(PackedMessage) == 8, "PackedMessage must stay 8 bytes");
+static_assert(is_trivially_copyable<PackedMessage>::value, "PackedMessage must be trivially copyable");
+
+namespace MessageLabels {
+    namespace {
+	// Entries are written once, under the lock, before count is raised, so
+	// readers of any id below count never need the lock.
+	string labels[MaxLabels];
+	atomic<int> count(1);
+	mutex writeLock;
+    }
+
+    int intern( const string& str ) {
+	if( str.empty() ) return 0;
+	int known = count.load(memory_order_acquire);
+	for( int i=1; i<known; i++ ) {
+	    if( labels[i] == str ) return i;
+	}
+
+	lock_guard<mutex> lock(writeLock);
+	int total = count.load(memory_order_relaxed);
+	for( int i=known; i<total; i++ ) {	// Added while we waited?
+	    if( labels[i] == str ) return i;
+	}
+	if( total == MaxLabels ) return 0;
+	labels[total] = str;
+	count.store(total+1, memory_order_release);
+	return total;
+    }
+
+    const string& name( int label ) {
+	return labels[label];
+    }
+}
+
+PackedMessage PackedMessage::pack( Message& msg, bool internLabel ) {
+    return PackedMessage( msg.getMessageType(), msg.getRow(), msg.getCol(), msg.getDirection(),
+                          msg.getLength(), internLabel ? MessageLabels::intern(msg.getString()) : 0 );
+}
+
+Message PackedMessage::unpack() const {
+    return Message( messageType, row, col, MessageLabels::name(label), Direction(dir), length );
+}
+
+const string& PackedMessage::getString() const {
+    return MessageLabels::name(label);
+}
@@ -0,0 +1,128 @@
+/**
+ * PackedMessage.h: an 8 byte, trivially copyable version of Message.
+ * Date:            October 2026
+ *
+ * Message carries a std::string, so every copy of it is a string copy. A
+ * PackedMessage holds the same information in 8 bytes and passes in a
+ * register. The optional string becomes a small label id; labels are
+ * interned once (e.g. in a function-local static) and looked up by id.
+ *
+ * Message itself cannot change: the provided player binaries build and
+ * receive Messages with the current layout. See PackedPlayerV2 for the
+ * player side of the packed protocol.
+ */
+
+#ifndef PACKEDMESSAGE_H		// Double inclusion protection
+#define PACKEDMESSAGE_H
+
+#include <string>
+#include <stdint.h>
+
+#include "defines.h"
+#include "Message.h"
+#include "Bitboard.h"
+
+using namespace std;
+
+class PackedMessage {
+    public:
+	PackedMessage() {}
+	PackedMessage( char messageType, int row = -1, int col = -1,
+	               Direction dir = None, int length = 0, int label = 0 ) {
+	    setMessage(messageType, row, col, dir, length, label);
+	}
+
+	/**
+	 * @brief Packs a Message. The string is interned only if internLabel is set,
+	 * since that costs a table lookup.
+	 */
+	static PackedMessage pack( Message& msg, bool internLabel = false );
+
+	/**
+	 * @brief Expands to a Message for players that only speak the old protocol.
+	 */
+	Message unpack() const;
+
+	void setMessage( char messageType, int row, int col, Direction dir, int length, int label ) {
+	    this->messageType = messageType;
+	    this->dir = dir;
+	    this->length = length;
+	    this->label = label;
+	    // Anything that doesn't fit is off the board anyway; keep it that way.
+	    this->row = row < INT16_MIN || row > INT16_MAX ? -1 : row;
+	    this->col = col < INT16_MIN || col > INT16_MAX ? -1 : col;
+	}
+
+	void setMessageType( char messageType ) { this->messageType = messageType; }
+	char getMessageType() const { return messageType; }
+
+	void setRow( int row ) { this->row = row; }
+	int getRow() const { return row; }
+
+	void setCol( int col ) { this->col = col; }
+	int getCol() const { return col; }
+
+	void setDirection( Direction dir ) { this->dir = dir; }
+	Direction getDirection() const { return Direction(dir); }
+
+	void setLength( int length ) { this->length = length; }
+	int getLength() const { return length; }
+
+	void setLabel( int label ) { this->label = label; }
+	int getLabel() const { return label; }
+	const string& getString() const;	// The label's text
+
+    private:
+	char messageType;
+	uint8_t dir;
+	int8_t length;		// -1 (unset) to MAX_SHIP_SIZE
+	uint8_t label;		// Interned string id, 0 = ""
+	int16_t row;
+	int16_t col;
+};
+
+/**
+ * @brief One sunk ship, reported in a single update. Replaces the HIT for the
+ * final shot and the KILL per ship cell that the old protocol sends.
+ */
+struct ShipKill {
+    int row, col;	// The shot that sank the ship
+    int boardSize;
+    Bitboard cells;	// Every cell of the ship, bit row*boardSize+col; empty
+			// on boards with more than Bitboard::Capacity cells
+    ShipLocation ship;	// Where the ship lies, on any board
+
+    // Every field, so a kill can't be made with some left out as zeros.
+    ShipKill( int row, int col, int boardSize, const Bitboard& cells, const ShipLocation& ship )
+	: row(row), col(col), boardSize(boardSize), cells(cells), ship(ship) {}
+    ShipKill() {}	// For records filled in later, as the sandbox's are
+
+    int length() const { return ship.length; }
+    // Cell i of the ship, 0 = top/left, in the order of the cells' indexes.
+    int cellRow( int i ) const { return ship.dir == Vertical ? ship.row + i : ship.row; }
+    int cellCol( int i ) const { return ship.dir == Vertical ? ship.col : ship.col + i; }
+    bool contains( int row, int col ) const {
+	int i = ship.dir == Vertical ? row - ship.row : col - ship.col;
+	return i >= 0 && i < ship.length && cellRow(i) == row && cellCol(i) == col;
+    }
+};
+
+/**
+ * @brief Interned message strings. Id 0 is always the empty string.
+ */
+namespace MessageLabels {
+    const int MaxLabels = 256;
+
+    /**
+     * @brief Returns the id of the string, adding it if new. Thread safe.
+     * Once the table is full, new strings get id 0.
+     */
+    int intern( const string& str );
+
+    /**
+     * @brief Returns the string for an id returned by intern().
+     */
+    const string& name( int label );
+}
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * PackedPlayerV2.cpp: the old player protocol on top of the packed one.
+ * Date:               October 2026
+ */
+
+#include "PackedPlayerV2.h"
+
+PackedPlayerV2::PackedPlayerV2( int boardSize )
+    :PlayerV2(boardSize)
+{
+}
+
+Message PackedPlayerV2::getMove() {
+    return getPackedMove().unpack();
+}
+
+void PackedPlayerV2::update( Message msg ) {
+    updatePacked( PackedMessage::pack(msg) );
+}
+
+Message PackedPlayerV2::placeShip( int length ) {
+    return placePackedShip(length).unpack();
+}
+
+void PackedPlayerV2::updateKill( const ShipKill& kill ) {
+    updatePacked( PackedMessage(HIT, kill.row, kill.col) );
+    for( int i=0; i<kill.length(); i++ ) {
+	updatePacked( PackedMessage(KILL, kill.cellRow(i), kill.cellCol(i)) );
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * PackedPlayerV2.h: base class for players that speak the packed protocol.
+ * Date:             October 2026
+ *
+ * A PackedPlayerV2 implements getPackedMove(), updatePacked() and
+ * placePackedShip() instead of getMove(), update() and placeShip(). AIContest
+ * notices (once per game) and calls the packed versions directly, so no
+ * Message or string is built on the way. The old entry points still work:
+ * they are implemented here on top of the packed ones.
+ *
+ * Sinking a ship arrives as one updateKill() call. The default turns it back
+ * into the old HIT + KILL-per-cell sequence; players that can take the whole
+ * ship at once override it.
+ *
+ * Packed players draw random numbers from rng, which AIContest sets to the
+ * player's own stream of the game before ships are placed.
+ */
+
+#ifndef PACKEDPLAYERV2_H		// Double inclusion protection
+#define PACKEDPLAYERV2_H
+
+#include "PlayerV2.h"
+#include "PackedMessage.h"
+#include "Random.h"
+
+class PackedPlayerV2: public PlayerV2 {
+    public:
+	PackedPlayerV2( int boardSize );
+
+	/**
+	 * @brief Packed version of getMove().
+	 */
+	virtual PackedMessage getPackedMove() = 0;
+
+	/**
+	 * @brief Packed version of update().
+	 */
+	virtual void updatePacked( PackedMessage msg ) = 0;
+
+	/**
+	 * @brief Packed version of placeShip().
+	 */
+	virtual PackedMessage placePackedShip( int length ) = 0;
+
+	/**
+	 * @brief A shot sank a ship. Defaults to the per-cell updates.
+	 */
+	virtual void updateKill( const ShipKill& kill );
+
+	/**
+	 * @brief True if the player can't go on with the game, which it then
+	 * loses (see SandboxPlayer).
+	 */
+	virtual bool forfeited() const { return false; }
+
+	/**
+	 * @brief Hands the player its random stream for the coming game.
+	 */
+	void setRandom( const Random& stream ) { rng = stream; }
+
+	// The old protocol, adapted to the packed one.
+	Message getMove() override;
+	void update( Message msg ) override;
+	Message placeShip( int length ) override;
+
+    protected:
+	Random rng;
+};
+
+#endif
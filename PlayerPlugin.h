@@ -0,0 +1,61 @@
+/**
+ * PlayerPlugin.h: what a player shared library exports, so contest and
+ *                 testAI can load it at startup (see Plugins.h).
+ * Date:           October 2026
+ *
+ * A plugin is one player built on its own, e.g. for ScanPlugin.cpp:
+ *
+ *   g++ -std=c++11 -fPIC -shared -o plugins/ParityScan.so ScanPlugin.cpp ScanPlayer.cpp
+ *
+ * Its source ends with
+ *
+ *   PLAYER_PLUGIN( ParityScanPlayer, "Parity Scan", "1.0", MAX_LARGE_BOARD_SIZE )
+ *
+ * which exports one C function, playerPlugin(), returning a PlayerPluginInfo
+ * with the player's name, its build's version, the largest board it plays
+ * and a factory. Only that function is looked up, so its name is all that
+ * has to stay stable between builds. The players themselves are still C++
+ * objects: a plugin must be built with the same compiler and the same
+ * headers as the programs, and it uses their PlayerV2, PackedPlayerV2,
+ * Random etc. (the programs are linked with -rdynamic for that), so it
+ * needs no more than its own player's sources.
+ */
+
+#ifndef PLAYERPLUGIN_H		// Double inclusion protection
+#define PLAYERPLUGIN_H
+
+#include "PlayerV2.h"
+#include "defines.h"
+
+// Changes whenever PlayerPluginInfo or the player classes change shape.
+#define PLAYER_PLUGIN_ABI 1
+
+extern "C" {
+    struct PlayerPluginInfo {
+	int abi;		// PLAYER_PLUGIN_ABI of the build
+	const char* name;	// As shown in results and matched by --players
+	const char* version;	// Of the player's build, e.g. "1.2" or a git hash
+	int maxBoardSize;	// Largest board the player plays on
+	PlayerV2* (*create)( int boardSize );	// A new player; the program deletes it
+    };
+
+    typedef const PlayerPluginInfo* (*PlayerPluginEntry)();
+}
+
+// The symbol Plugins.cpp looks up.
+#define PLAYER_PLUGIN_ENTRY "playerPlugin"
+
+/**
+ * @brief Exports PlayerClass, made as new PlayerClass(boardSize), as a plugin.
+ */
+#define PLAYER_PLUGIN( PlayerClass, name, version, maxBoardSize )		\
+    static PlayerV2* createPluginPlayer( int boardSize ) {			\
+	return new PlayerClass( boardSize );					\
+    }									\
+    extern "C" const PlayerPluginInfo* playerPlugin() {				\
+	static const PlayerPluginInfo info = { PLAYER_PLUGIN_ABI, name, version,	\
+					       maxBoardSize, createPluginPlayer };	\
+	return &info;								\
+    }
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * PlayerTiming.cpp: how long the players take per call.
+ * Date:             October 2026
+ */
+
+#include <iomanip>
+#include <cmath>
+
+#include "PlayerTiming.h"
+
+using namespace std;
+
+LatencyHistogram::LatencyHistogram() {
+    for( int i=0; i<NumBuckets; i++ ) counts[i] = 0;
+    total = 0;
+    maxValue = 0;
+}
+
+void LatencyHistogram::add( const LatencyHistogram& other ) {
+    for( int i=0; i<NumBuckets; i++ ) counts[i] += other.counts[i];
+    total += other.total;
+    if( other.maxValue > maxValue ) maxValue = other.maxValue;
+}
+
+uint64_t LatencyHistogram::percentile( double fraction ) const {
+    if( total == 0 ) return 0;
+    uint64_t wanted = uint64_t(ceil(fraction * total));
+    if( wanted < 1 ) wanted = 1;
+    uint64_t seen = 0;
+    for( int i=0; i<NumBuckets; i++ ) {
+	seen += counts[i];
+	if( seen >= wanted ) {
+	    return bucketHigh(i) < maxValue ? bucketHigh(i) : maxValue;
+	}
+    }
+    return maxValue;
+}
+
+uint64_t LatencyHistogram::bucketLow( int bucket ) {
+    if( bucket < 2*SubBuckets ) return bucket;
+    int shift = bucket/SubBuckets - 1;
+    return uint64_t(bucket%SubBuckets + SubBuckets) << shift;
+}
+
+uint64_t LatencyHistogram::bucketHigh( int bucket ) {
+    if( bucket < 2*SubBuckets ) return bucket;
+    int shift = bucket/SubBuckets - 1;
+    return (uint64_t(bucket%SubBuckets + SubBuckets + 1) << shift) - 1;
+}
+
+const char* playerCallName( PlayerCall call ) {
+    static const char* names[NumPlayerCalls] = { "newRound", "getMove", "update", "placeShip" };
+    return names[call];
+}
+
+void PlayerTiming::add( const PlayerTiming& other ) {
+    for( int call=0; call<NumPlayerCalls; call++ ) {
+	calls[call].add(other.calls[call]);
+    }
+}
+
+void printTimingTable( ostream& out, const string playerNames[2], const PlayerTiming timing[2] ) {
+    out << left << setw(20) << "Player" << setw(11) << "Call" << right << setw(12) << "Calls"
+	<< setw(12) << "p50 ns" << setw(12) << "p99 ns" << setw(12) << "max ns" << endl;
+    for( int side=0; side<2; side++ ) {
+	for( int call=0; call<NumPlayerCalls; call++ ) {
+	    const LatencyHistogram& histogram = timing[side].calls[call];
+	    out << left << setw(20) << playerNames[side].substr(0, 19) << setw(11) << playerCallName(PlayerCall(call))
+		<< right << setw(12) << histogram.count() << setw(12) << histogram.percentile(0.5)
+		<< setw(12) << histogram.percentile(0.99) << setw(12) << histogram.max() << endl;
+	}
+    }
+}
+
+void writeTimingCsvHeader( ostream& out ) {
+    out << "player1,player2,player,call,low_ns,high_ns,count" << endl;
+}
+
+void writeTimingCsv( ostream& out, const string playerNames[2], const PlayerTiming timing[2] ) {
+    for( int side=0; side<2; side++ ) {
+	for( int call=0; call<NumPlayerCalls; call++ ) {
+	    const LatencyHistogram& histogram = timing[side].calls[call];
+	    for( int bucket=0; bucket<LatencyHistogram::NumBuckets; bucket++ ) {
+		if( histogram.bucketCount(bucket) == 0 ) continue;
+		out << playerNames[0] << "," << playerNames[1] << "," << playerNames[side] << ","
+		    << playerCallName(PlayerCall(call)) << "," << LatencyHistogram::bucketLow(bucket) << ","
+		    << LatencyHistogram::bucketHigh(bucket) << "," << histogram.bucketCount(bucket) << endl;
+	    }
+	}
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * PlayerTiming.h: how long the players take per call.
+ * Date:           October 2026
+ *
+ * With timing on (--timing), AIContest times every call into a player
+ * (getMove, update, placeShip; MatchRunner times newRound) on the monotonic
+ * clock and counts it in that player's LatencyHistogram for the call.
+ * The histograms are log-linear like HdrHistogram: exact below 128 ns, and
+ * within 1/64 (about 1.5%) of the true value above, with a fixed number of
+ * buckets, so recording is a few instructions and histograms from several
+ * threads simply add up.
+ */
+
+#ifndef PLAYERTIMING_H		// Double inclusion protection
+#define PLAYERTIMING_H
+
+#include <stdint.h>
+#include <time.h>
+#include <string>
+#include <ostream>
+
+using namespace std;
+
+class LatencyHistogram {
+  public:
+    static const int SubBucketBits = 6;
+    static const int SubBuckets = 1 << SubBucketBits;
+    static const int MaxShift = 34;	// Values up to 2^41 ns (about 36 minutes)
+    static const int NumBuckets = (MaxShift+2) * SubBuckets;
+
+    LatencyHistogram();
+
+    void record( uint64_t nanos ) {
+	if( nanos > maxValue ) maxValue = nanos;
+	total++;
+	counts[bucketOf(nanos)]++;
+    }
+
+    void add( const LatencyHistogram& other );
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxValue; }
+
+    /**
+     * @brief The smallest recorded value (bucket upper bound) that at least
+     * fraction of the calls did not exceed, e.g. 0.99 for p99. 0 if empty.
+     */
+    uint64_t percentile( double fraction ) const;
+
+    // The buckets, for dumping.
+    uint64_t bucketCount( int bucket ) const { return counts[bucket]; }
+    static uint64_t bucketLow( int bucket );
+    static uint64_t bucketHigh( int bucket );
+
+    static int bucketOf( uint64_t nanos ) {
+	if( nanos < 2*SubBuckets ) return int(nanos);
+	int shift = 63 - __builtin_clzll(nanos) - SubBucketBits;
+	if( shift > MaxShift ) return NumBuckets-1;
+	return shift*SubBuckets + int(nanos >> shift);
+    }
+
+  private:
+    uint64_t counts[NumBuckets];
+    uint64_t total;
+    uint64_t maxValue;
+};
+
+enum PlayerCall { NewRoundCall, GetMoveCall, UpdateCall, PlaceShipCall, NumPlayerCalls };
+
+const char* playerCallName( PlayerCall call );
+
+/**
+ * @brief One player's call latencies.
+ */
+struct PlayerTiming {
+    void add( const PlayerTiming& other );
+
+    LatencyHistogram calls[NumPlayerCalls];
+};
+
+/**
+ * @brief Nanoseconds on the monotonic clock (vDSO, no system call).
+ */
+inline uint64_t monotonicNanos() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec)*1000000000 + now.tv_nsec;
+}
+
+/**
+ * @brief Times a scope into timing->calls[call]; does nothing if timing is null.
+ */
+class CallTimer {
+  public:
+    CallTimer( PlayerTiming* timing, PlayerCall call ) : timing(timing), call(call) {
+	if( timing ) start = monotonicNanos();
+    }
+    ~CallTimer() {
+	if( timing ) timing->calls[call].record(monotonicNanos() - start);
+    }
+
+  private:
+    PlayerTiming* timing;
+    PlayerCall call;
+    uint64_t start;
+};
+
+/**
+ * @brief Prints calls, p50, p99 and max per player and call, in nanoseconds.
+ */
+void printTimingTable( ostream& out, const string playerNames[2], const PlayerTiming timing[2] );
+
+/**
+ * @brief Writes the header line of writeTimingCsv()'s rows.
+ */
+void writeTimingCsvHeader( ostream& out );
+
+/**
+ * @brief Writes one row per non-empty bucket:
+ * player1,player2,player,call,low_ns,high_ns,count
+ */
+void writeTimingCsv( ostream& out, const string playerNames[2], const PlayerTiming timing[2] );
+
+#endif
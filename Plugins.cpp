@@ -0,0 +1,81 @@
+/**
+ * Plugins.cpp: players loaded from shared libraries at startup.
+ * Date:        October 2026
+ */
+
+#include <algorithm>
+#include <dirent.h>
+#include <dlfcn.h>
+
+#include "Plugins.h"
+
+using namespace std;
+
+PluginRegistry::~PluginRegistry() {
+    unload();
+}
+
+bool PluginRegistry::load( const string& directory, const string takenNames[], int numTaken ) {
+    DIR* dir = opendir(directory.c_str());
+    if( !dir ) return false;
+    vector<string> files;
+    while( struct dirent* entry = readdir(dir) ) {
+	string file = entry->d_name;
+	if( file.size() > 3 && file.compare(file.size()-3, 3, ".so") == 0 ) files.push_back(directory + "/" + file);
+    }
+    closedir(dir);
+    sort(files.begin(), files.end());
+
+    for( size_t i=0; i<files.size(); i++ ) {
+	const string& file = files[i];
+	// RTLD_NOW: a missing symbol is found here, not in the middle of a game.
+	void* handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if( !handle ) {
+	    skipped.push_back(dlerror());
+	    continue;
+	}
+	PlayerPluginEntry entry = (PlayerPluginEntry)dlsym(handle, PLAYER_PLUGIN_ENTRY);
+	const PlayerPluginInfo* info = entry ? entry() : 0;
+	string problem;
+	if( !info ) {
+	    problem = "no " PLAYER_PLUGIN_ENTRY "()";
+	} else if( info->abi != PLAYER_PLUGIN_ABI ) {
+	    problem = "built for plugin ABI " + to_string(info->abi) + ", not " + to_string(PLAYER_PLUGIN_ABI);
+	} else if( !info->name || !info->create ) {
+	    problem = "no name or no factory";
+	} else if( taken(info->name, takenNames, numTaken) ) {
+	    problem = string("there is already a player called '") + info->name + "'";
+	}
+	if( !problem.empty() ) {
+	    skipped.push_back(file + ": " + problem);
+	    dlclose(handle);
+	    continue;
+	}
+	PluginPlayer player;
+	player.name = info->name;
+	player.version = info->version ? info->version : "";
+	player.file = file;
+	player.maxBoardSize = info->maxBoardSize;
+	player.create = info->create;
+	players.push_back(player);
+	handles.push_back(handle);
+    }
+    return true;
+}
+
+void PluginRegistry::unload() {
+    players.clear();
+    for( size_t i=0; i<handles.size(); i++ ) dlclose(handles[i]);
+    handles.clear();
+    skipped.clear();
+}
+
+bool PluginRegistry::taken( const string& name, const string takenNames[], int numTaken ) const {
+    for( int i=0; i<numTaken; i++ ) {
+	if( takenNames[i] == name ) return true;
+    }
+    for( size_t i=0; i<players.size(); i++ ) {
+	if( players[i].name == name ) return true;
+    }
+    return false;
+}
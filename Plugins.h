@@ -0,0 +1,76 @@
+/**
+ * Plugins.h: players loaded from shared libraries at startup.
+ * Date:      October 2026
+ *
+ * contest and testAI dlopen() every *.so in the plugin directory (--plugins,
+ * default ./plugins) and add its player after the built-in ones, so a new
+ * build of an AI takes compiling one library (see PlayerPlugin.h) instead
+ * of relinking the programs. A library that can't be loaded, has no
+ * playerPlugin(), was built for another PLAYER_PLUGIN_ABI or reuses a name
+ * already taken is skipped, with the reason in problems().
+ *
+ * Libraries are found in name order, so the players' numbers don't change
+ * from run to run. Each run loads what is in the directory when it starts:
+ * to swap in a new build between batches, move it into place (mv, or let
+ * the linker write it) rather than copying over the old file, which a
+ * running tournament still has mapped.
+ */
+
+#ifndef PLUGINS_H		// Double inclusion protection
+#define PLUGINS_H
+
+#include <string>
+#include <vector>
+
+#include "PlayerPlugin.h"
+
+using namespace std;
+
+/**
+ * @brief One player from a plugin.
+ */
+struct PluginPlayer {
+    string name;
+    string version;
+    string file;		// The library it came from
+    int maxBoardSize;
+    PlayerV2* (*create)( int boardSize );
+};
+
+class PluginRegistry {
+    public:
+	PluginRegistry() {}
+	~PluginRegistry();
+
+	/**
+	 * @brief Loads the plugins in directory, after any loaded before.
+	 * @param takenNames Names a plugin may not use (the built-in players').
+	 * @return false if the directory can't be read.
+	 */
+	bool load( const string& directory, const string takenNames[], int numTaken );
+
+	/**
+	 * @brief Closes every library. No player from them may be left.
+	 */
+	void unload();
+
+	int size() const { return players.size(); }
+	const PluginPlayer& operator[]( int i ) const { return players[i]; }
+
+	/**
+	 * @brief Libraries skipped by load(), and why.
+	 */
+	const vector<string>& problems() const { return skipped; }
+
+    private:
+	PluginRegistry( const PluginRegistry& );
+	void operator=( const PluginRegistry& );
+
+	bool taken( const string& name, const string takenNames[], int numTaken ) const;
+
+	vector<PluginPlayer> players;
+	vector<void*> handles;
+	vector<string> skipped;
+};
+
+#endif
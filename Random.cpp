@@ -0,0 +1,91 @@
+/**
+ * Random.cpp: per-thread rand()/random() streams and the Random generator.
+ * Date:       October 2026
+ *
+ * Each thread owns a glibc random_r() state. The libc entry points below take
+ * precedence over the C library's versions when linked into the program.
+ */
+
+#include <stdlib.h>
+
+#include "Random.h"
+
+namespace {
+    const int StateBytes = 128;		// Same state size glibc uses for random()
+
+    struct ThreadStream {
+	ThreadStream() : seeded(false) {}
+	bool seeded;
+	struct random_data data;
+	char state[StateBytes];
+    };
+
+    thread_local ThreadStream stream;
+
+    void seedStream( unsigned int seed ) {
+	stream.data.state = 0;	// initstate_r requires a cleared random_data
+	initstate_r(seed, stream.state, StateBytes, &stream.data);
+	stream.seeded = true;
+    }
+
+    int32_t nextRandom() {
+	if( !stream.seeded ) {
+	    seedStream(1);	// glibc's default seed
+	}
+	int32_t result;
+	random_r(&stream.data, &result);
+	return result;
+    }
+
+    uint64_t splitmix64( uint64_t x ) {
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+    }
+}
+
+void seedThreadRandom( unsigned int seed ) {
+    seedStream(seed);
+}
+
+Random::Random( uint64_t seed ) {
+    // xoshiro must not start from all zeros; splitmix64 never gives four.
+    for( int i=0; i<4; i++ ) {
+	seed = s[i] = splitmix64(seed);
+    }
+}
+
+Random Random::forGame( const GameId& game, Stream stream ) {
+    uint64_t h = splitmix64(game.seed);
+    h = splitmix64(h ^ uint64_t(int64_t(game.pairing)));
+    h = splitmix64(h ^ uint64_t(int64_t(game.round)));
+    return Random(h ^ uint64_t(stream));
+}
+
+unsigned int mixSeed( uint64_t seed, int64_t a, int64_t b, int64_t c ) {
+    uint64_t h = splitmix64(seed);
+    h = splitmix64(h ^ uint64_t(a));
+    h = splitmix64(h ^ uint64_t(b));
+    h = splitmix64(h ^ uint64_t(c));
+    return (unsigned int)(h >> 32);
+}
+
+// The C library entry points, redirected to the calling thread's stream.
+extern "C" {
+    int rand( void ) __THROW {
+	return nextRandom();
+    }
+
+    long int random( void ) __THROW {
+	return nextRandom();
+    }
+
+    void srand( unsigned int seed ) __THROW {
+	seedStream(seed);
+    }
+
+    void srandom( unsigned int seed ) __THROW {
+	seedStream(seed);
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * Random.h: per-thread random number streams for games.
+ * Date:     October 2026
+ *
+ * The program defines its own rand()/random()/srand()/srandom(), so every
+ * player -- including the provided player binaries -- draws from a stream
+ * that belongs to the calling thread. Each thread runs with glibc's own
+ * random() algorithm, so a single thread seeded with srand(s) produces the
+ * same numbers it always did.
+ *
+ * Games are reseeded from mixSeed() at fixed points (start of a match
+ * block, start of each round), so a round's random numbers depend only on
+ * the tournament seed and the round's place in the tournament, never on
+ * which thread played it or what else ran before.
+ *
+ * Code built with this project should use Random instead: a xoshiro256**
+ * generator with one stream per (seed, pairing, round, player), so a game
+ * can be replayed from its GameId alone. AIContest hands each packed player
+ * its stream at the start of the game (see PackedPlayerV2).
+ */
+
+#ifndef RANDOM_H		// Double inclusion protection
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Seeds the calling thread's stream, exactly like srandom(seed).
+ */
+void seedThreadRandom( unsigned int seed );
+
+/**
+ * @brief Derives a well mixed 32 bit seed from a tournament seed and
+ * up to three coordinates (e.g. pairing and round).
+ */
+unsigned int mixSeed( uint64_t seed, int64_t a, int64_t b = 0, int64_t c = 0 );
+
+/**
+ * @brief Identifies one game of a tournament. Its random numbers, and so
+ * the game itself, depend on nothing else (besides the players' memory of
+ * earlier rounds of the same block).
+ */
+struct GameId {
+    uint64_t seed;	// Tournament seed
+    int pairing;	// Position of the match in the tournament
+    int round;
+};
+
+/**
+ * @brief xoshiro256** random number generator.
+ */
+class Random {
+  public:
+    // Streams of a game, one per party.
+    enum Stream { Controller = 0, Player1 = 1, Player2 = 2 };
+
+    Random( uint64_t seed = 0 );
+
+    /**
+     * @brief The stream of one party in one game.
+     */
+    static Random forGame( const GameId& game, Stream stream );
+
+    uint64_t next() {
+	uint64_t result = rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+	return result;
+    }
+
+    /**
+     * @brief A number in [0, bound), by multiply and shift (no division).
+     */
+    uint32_t below( uint32_t bound ) {
+	return uint32_t(((next() >> 32) * bound) >> 32);
+    }
+
+  private:
+    static uint64_t rotl( uint64_t x, int k ) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s[4];
+};
+
+#endif
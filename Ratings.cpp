@@ -0,0 +1,210 @@
+/**
+ * Ratings.cpp: Glicko-2 ratings of the AIs, kept from run to run.
+ * Date:        October 2026
+ *
+ * The formulas and the names (mu, phi, sigma, v, delta, tau) follow
+ * Glickman, "Example of the Glicko-2 system".
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "Ratings.h"
+
+using namespace std;
+
+const double RatingTable::InitialRating = 1500;
+const double RatingTable::InitialDeviation = 350;
+const double RatingTable::InitialVolatility = 0.06;
+
+namespace {
+    const double Scale = 173.7178;	// Glicko points per Glicko-2 unit
+    const double Tau = 0.5;		// How far the volatility may move per period
+    const int GamesPerPeriod = 12;	// Of a match; see addMatch()
+    const double MaxVolatility = 0.15;	// Above it a sweep feeds on itself
+    const double Epsilon = 0.000001;
+    const double Pi = 3.14159265358979323846;
+
+    // Period's part of count, when count is spread evenly over periods.
+    int share( int count, int period, int periods ) {
+	return (long long)count*(period+1)/periods - (long long)count*period/periods;
+    }
+
+    double g( double phi ) {
+	return 1 / sqrt(1 + 3*phi*phi/(Pi*Pi));
+    }
+
+    double expected( double mu, double opponentMu, double opponentPhi ) {
+	return 1 / (1 + exp(-g(opponentPhi) * (mu - opponentMu)));
+    }
+
+    /*
+     * New volatility from the period's improvement delta and variance v
+     * (step 5, the Illinois method).
+     */
+    double newVolatility( double sigma, double phi, double v, double delta ) {
+	double a = log(sigma*sigma);
+	double phi2 = phi*phi;
+	struct F {
+	    double a, phi2, v, delta2;
+	    double operator()( double x ) const {
+		double ex = exp(x);
+		return ex*(delta2 - phi2 - v - ex) / (2*(phi2+v+ex)*(phi2+v+ex)) - (x-a)/(Tau*Tau);
+	    }
+	} f = { a, phi2, v, delta*delta };
+
+	double A = a, B;
+	if( delta*delta > phi2 + v ) {
+	    B = log(delta*delta - phi2 - v);
+	} else {
+	    int k = 1;
+	    while( f(a - k*Tau) < 0 ) k++;
+	    B = a - k*Tau;
+	}
+	double fA = f(A), fB = f(B);
+	while( fabs(B-A) > Epsilon ) {
+	    double C = A + (A-B)*fA/(fB-fA);
+	    double fC = f(C);
+	    if( fC*fB <= 0 ) {
+		A = B;
+		fA = fB;
+	    } else {
+		fA /= 2;
+	    }
+	    B = C;
+	    fB = fC;
+	}
+	return exp(A/2);
+    }
+}
+
+RatingTable::RatingTable( int boardSize ) {
+    this->boardSize = boardSize;
+}
+
+bool RatingTable::load( const string& fileName ) {
+    ratings.clear();
+    problem = "";
+    ifstream in(fileName.c_str());
+    if( !in ) return true;	// Nobody rated yet
+
+    string line, magic, board;
+    int size = 0;
+    getline(in, line);
+    stringstream header(line);
+    if( !(header >> magic >> board >> size) || magic != "glicko2" || board != "board" ) {
+	problem = fileName + " is not a ratings file";
+	return false;
+    }
+    if( size != boardSize ) {
+	problem = fileName + " has ratings for " + to_string(size) + "x" + to_string(size) + " boards";
+	return false;
+    }
+    int lineNumber = 1;
+    while( getline(in, line) ) {
+	lineNumber++;
+	if( line.empty() ) continue;
+	stringstream fields(line);
+	Rating rating;
+	if( !(fields >> rating.rating >> rating.deviation >> rating.volatility >> rating.games) ) {
+	    problem = fileName + ":" + to_string(lineNumber) + ": bad rating";
+	    return false;
+	}
+	fields >> ws;
+	getline(fields, rating.name);
+	ratings.push_back(rating);
+    }
+    return true;
+}
+
+bool RatingTable::save( const string& fileName ) {
+    // Write a new file and move it into place, so a crash can't lose the old one.
+    string temporary = fileName + ".new";
+    ofstream out(temporary.c_str());
+    out << "glicko2 board " << boardSize << endl;
+    for( size_t i=0; i<ratings.size(); i++ ) {
+	const Rating& rating = ratings[i];
+	out << fixed << setprecision(2) << rating.rating << " " << rating.deviation << " " << setprecision(6)
+	    << rating.volatility << " " << rating.games << " " << rating.name << endl;
+    }
+    out.close();
+    if( !out || rename(temporary.c_str(), fileName.c_str()) != 0 ) {
+	problem = "can't write " + fileName;
+	return false;
+    }
+    return true;
+}
+
+int RatingTable::find( const string& name ) {
+    for( size_t i=0; i<ratings.size(); i++ ) {
+	if( ratings[i].name == name ) return i;
+    }
+    Rating rating = { name, InitialRating, InitialDeviation, InitialVolatility, 0 };
+    ratings.push_back(rating);
+    return ratings.size() - 1;
+}
+
+/**
+ * Rates the match as periods of about GamesPerPeriod games, its wins,
+ * losses and ties spread evenly over them. As one period, a long one-sided
+ * match has delta^2 far above phi^2 + v, which drives the volatility, and
+ * with it the deviation, up instead of down.
+ */
+void RatingTable::addMatch( int a, int b, int wins, int losses, int ties ) {
+    int games = wins + losses + ties;
+    int periods = (games + GamesPerPeriod-1) / GamesPerPeriod;
+    for( int period=0; period<periods; period++ ) {
+	ratePeriod(a, b, share(wins, period, periods), share(losses, period, periods), share(ties, period, periods),
+		   periods);
+    }
+}
+
+void RatingTable::ratePeriod( int a, int b, int wins, int losses, int ties, int periods ) {
+    int games = wins + losses + ties;
+    if( games == 0 ) return;
+    int players[2] = { a, b };
+    double scores[2] = { wins + ties/2.0, losses + ties/2.0 };
+    double mu[2], phi[2];
+    for( int side=0; side<2; side++ ) {
+	mu[side] = (ratings[players[side]].rating - InitialRating) / Scale;
+	phi[side] = ratings[players[side]].deviation / Scale;
+    }
+
+    // Both players are updated from the ratings they had before the match.
+    for( int side=0; side<2; side++ ) {
+	Rating& rating = ratings[players[side]];
+	int other = 1 - side;
+	double gOther = g(phi[other]);
+	double E = expected(mu[side], mu[other], phi[other]);
+	double v = 1 / (games * gOther*gOther * E*(1-E));
+	double improvement = gOther * (scores[side] - games*E);
+	double delta = v * improvement;
+
+	double sigma = min(newVolatility(rating.volatility, phi[side], v, delta), MaxVolatility);
+	double phiStar = sqrt(phi[side]*phi[side] + sigma*sigma/periods);
+	double newPhi = 1 / sqrt(1/(phiStar*phiStar) + 1/v);
+	double newMu = mu[side] + newPhi*newPhi * improvement;
+
+	rating.rating = newMu*Scale + InitialRating;
+	rating.deviation = newPhi*Scale;
+	rating.volatility = sigma;
+	rating.games += games;
+    }
+}
+
+double RatingTable::information( int a, int b ) const {
+    double muA = (ratings[a].rating - InitialRating) / Scale;
+    double muB = (ratings[b].rating - InitialRating) / Scale;
+    double gB = g(ratings[b].deviation / Scale);
+    double E = expected(muA, muB, ratings[b].deviation / Scale);
+    return gB*gB * E*(1-E);
+}
+
+void RatingTable::interval( int player, double& low, double& high ) const {
+    low = ratings[player].rating - 1.96*ratings[player].deviation;
+    high = ratings[player].rating + 1.96*ratings[player].deviation;
+}
@@ -0,0 +1,91 @@
+/**
+ * Ratings.h: Glicko-2 ratings of the AIs, kept from run to run.
+ * Date:      October 2026
+ *
+ * Each player has a rating (1500 to start), a rating deviation (how unsure
+ * the rating is; 350 to start) and a volatility, as in Glickman's
+ * Glicko-2. Every round of a match is one game (a tie is half a win), and
+ * the match is rated as rating periods of a dozen or so games each: one
+ * period of hundreds of games, all won by one side, would send the
+ * volatility up and the deviation with it. The volatility is also kept
+ * below 0.15. Players who sit a match out keep their deviation: there are
+ * no idle rating periods.
+ *
+ * The deviation tells how many more games a player needs. contest
+ * --ratings FILE plays only the matches that teach the most (see
+ * information()) until every entrant's deviation is small, so a new AI
+ * costs the games needed to place it, not a round robin.
+ *
+ * The file is text, one player per line after a header naming the board
+ * size, since ratings on different boards don't compare:
+ *
+ *   glicko2 board 10
+ *   1623.41 45.2 0.0599 1200 Density Player
+ */
+
+#ifndef RATINGS_H		// Double inclusion protection
+#define RATINGS_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Rating {
+    string name;
+    double rating;
+    double deviation;
+    double volatility;
+    long games;
+};
+
+class RatingTable {
+  public:
+    RatingTable( int boardSize );
+
+    /**
+     * @brief Reads the ratings in fileName; a missing file is an empty table.
+     * @return false if the file is damaged or for another board size.
+     */
+    bool load( const string& fileName );
+    bool save( const string& fileName );
+    const string& error() const { return problem; }
+
+    /**
+     * @brief The player's index, adding a new, unrated player if needed.
+     */
+    int find( const string& name );
+
+    int size() const { return ratings.size(); }
+    const Rating& operator[]( int player ) const { return ratings[player]; }
+
+    /**
+     * @brief Rates one match of wins + losses + ties rounds between a and b.
+     * @param wins Rounds a won.
+     */
+    void addMatch( int a, int b, int wins, int losses, int ties );
+
+    /**
+     * @brief Fisher information one game between a and b gives about a's
+     * rating: high for close, well rated opponents.
+     */
+    double information( int a, int b ) const;
+
+    /**
+     * @brief rating -/+ 1.96 deviations: a 95% interval.
+     */
+    void interval( int player, double& low, double& high ) const;
+
+    static const double InitialRating;
+    static const double InitialDeviation;
+    static const double InitialVolatility;
+
+  private:
+    void ratePeriod( int a, int b, int wins, int losses, int ties, int periods );
+
+    int boardSize;
+    vector<Rating> ratings;
+    string problem;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * Authors Stefan Brandle and Jonathan Geisler
+ * Date    November, 2004
+ * Declaration source file for ReferenceBoardV3.
+ *
+ * This is the original char-array BoardV3. The game runs on the bitboard
+ * BoardV3; this copy is kept as the reference the bitboard version is
+ * checked against (see the board section of benchmark.cpp).
+ */
+
+#ifndef REFERENCEBOARDV3_H
+#define REFERENCEBOARDV3_H
+
+#include "defines.h"
+
+using namespace std;
+
+class ReferenceBoardV3 {
+    public:
+	// Constructors and such
+	ReferenceBoardV3( int width);		
+	ReferenceBoardV3(const ReferenceBoardV3& other);
+	void operator=(const ReferenceBoardV3& other);
+	// General public access functions.
+	bool placeShip(int row, int col, int length, Direction dir);
+    	char getOpponentView(int row, int col);
+    	char getOwnerView(int row, int col);
+    	char getShipMark(int row, int col);
+    	char processShot(int row, int col);
+    	bool hasWon();
+
+        const static int MaxBoardSize = 10;     // Maximum board size.
+
+    private:
+	// Put prototypes for your private helper functions here.
+	void initialize(char board[MaxBoardSize][MaxBoardSize]);
+	bool positionOk(int row, int col, int length, bool horiz);
+	void markShip(int row, int col, int length, bool horiz);
+        bool isSunk(int row, int col);
+        void markSunk(int row, int col);
+
+	// Suggested data variables. Although you can ignore these, it
+	// is suggested that you use them. If you change the array definitions,
+	// you may have to change some of the prototypes or code that 
+	// you are given as part of your starter kit.
+	char shipBoard[MaxBoardSize][MaxBoardSize];    // Tracks the placed ships and shots
+	char shotBoard[MaxBoardSize][MaxBoardSize];    // Tracks where ships are through whole game
+	int boardSize;		    // Tracks how many rows/cols are actually being used.
+
+	// Put your private data variables here.
+	char shipMark;		    // Used to mark the ships on shipBoard
+};
+
+#endif	// End of multiple inclusion control.
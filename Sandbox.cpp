@@ -0,0 +1,298 @@
+/**
+ * Sandbox.cpp: runs a player in its own process, with time and memory limits.
+ * Date:        October 2026
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/prctl.h>
+
+#include "Sandbox.h"
+#include "OpponentModels.h"
+#include "Diagnostics.h"
+
+using namespace std;
+
+namespace {
+    // Longest single wait before checking that the child still lives.
+    const int SliceMillis = 10;
+
+    // The process's address space now, from /proc/self/statm.
+    long addressSpace() {
+	FILE* statm = fopen("/proc/self/statm", "r");
+	long pages = 0;
+	if( statm ) {
+	    if( fscanf(statm, "%ld", &pages) != 1 ) pages = 0;
+	    fclose(statm);
+	}
+	return pages * sysconf(_SC_PAGESIZE);
+    }
+}
+
+PlayerHost::PlayerHost( PlayerV2* player ) {
+    this->player = player;
+    this->packed = dynamic_cast<PackedPlayerV2*>(player);
+}
+
+PlayerHost::~PlayerHost() {
+    delete player;
+}
+
+/**
+ * Speaks to players on either protocol, as AIContest does.
+ */
+bool PlayerHost::handle( SandboxRecord& record ) {
+    if( packed && record.haveRng ) packed->setRandom(record.rng);
+    switch( record.call ) {
+	case SandboxRecord::NewRound:
+	    seedThreadRandom(record.value);
+	    player->newRound();
+	    return false;
+	case SandboxRecord::PlaceShip:
+	    if( packed ) {
+		record.msg = packed->placePackedShip(record.value);
+	    } else {
+		Message loc = player->placeShip(record.value);
+		record.msg = PackedMessage::pack(loc);
+	    }
+	    break;
+	case SandboxRecord::GetMove:
+	    if( packed ) {
+		record.msg = packed->getPackedMove();
+	    } else {
+		Message move = player->getMove();
+		record.msg = PackedMessage::pack(move);
+	    }
+	    break;
+	case SandboxRecord::Update:
+	    if( packed ) packed->updatePacked(record.msg);
+	    else player->update(record.msg.unpack());
+	    return false;
+	case SandboxRecord::Kill:
+	    if( packed ) {
+		packed->updateKill(record.kill);
+	    } else {
+		player->update(PackedMessage( HIT, record.kill.row, record.kill.col ).unpack());
+		for( int i=0; i<record.kill.length(); i++ ) {
+		    player->update(PackedMessage( KILL, record.kill.cellRow(i), record.kill.cellCol(i) ).unpack());
+		}
+	    }
+	    return false;
+	default:
+	    return false;
+    }
+    record.call = SandboxRecord::Reply;
+    return true;
+}
+
+void PlayerHost::serve( SandboxRing& requests, SandboxRing& replies ) {
+    SandboxRecord record = SandboxRecord();
+    while( requests.pop(record, -1) && record.call != SandboxRecord::Quit ) {
+	if( handle(record) ) replies.push(record, -1);
+    }
+    delete player;
+    player = 0;
+    record.call = SandboxRecord::Reply;
+    replies.push(record, -1);
+}
+
+SandboxPlayer::SandboxPlayer( PlayerFactory getPlayer, int playerId, int boardSize, const string& name,
+                              const SandboxLimits& limits )
+    :PackedPlayerV2(boardSize)
+{
+    this->getPlayer = getPlayer;
+    this->playerId = playerId;
+    this->name = name;
+    this->opponent = &OpponentModels::opponent();
+    this->limits = limits;
+    this->child = -1;
+    this->requests = 0;
+    this->replies = 0;
+    this->lost = false;
+    this->newGame = true;
+    start();
+}
+
+SandboxPlayer::~SandboxPlayer() {
+    stop();
+}
+
+/*
+ * Forks the child. It makes the player from the same random state the
+ * player would have seen here.
+ */
+void SandboxPlayer::start() {
+    requests = SandboxRing::create();
+    replies = SandboxRing::create();
+    if( !requests || !replies ) {
+	fail("can't get shared memory");
+	return;
+    }
+    child = fork();
+    if( child == 0 ) {
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+	struct rlimit limit;
+	limit.rlim_cur = limit.rlim_max = addressSpace() + limits.memoryBytes;
+	setrlimit(RLIMIT_AS, &limit);
+	OpponentModels::setOpponent(opponent);	// Also for a child started after a forfeit
+	PlayerHost host( getPlayer(playerId, boardSize) );
+	host.serve(*requests, *replies);
+	Diagnostics::flush();	// The player's files; exit() would have, _exit() doesn't
+	_exit(0);	// Not exit(): the controller's buffers and atexit handlers aren't ours
+    }
+    if( child < 0 ) {
+	fail("can't start a process");
+    }
+}
+
+/*
+ * Ends the child: asks it to delete its player and exit, and kills it if
+ * that takes longer than a move.
+ */
+void SandboxPlayer::stop() {
+    if( child > 0 ) {
+	SandboxRecord record = SandboxRecord();
+	record.call = SandboxRecord::Quit;
+	startClock();
+	if( !send(record, true) || !receive(record) ) {
+	    if( child > 0 ) kill(child, SIGKILL);
+	}
+	if( child > 0 ) waitpid(child, 0, 0);
+	child = -1;
+    }
+    SandboxRing::destroy(requests);
+    SandboxRing::destroy(replies);
+    requests = replies = 0;
+}
+
+void SandboxPlayer::fail( const string& why ) {
+    if( child > 0 ) {
+	kill(child, SIGKILL);
+	waitpid(child, 0, 0);
+	child = -1;
+    }
+    cerr << "Sandbox: " << name << " " << why << "; forfeits the game" << endl;
+    stop();
+    lost = true;
+}
+
+/*
+ * True if the child has ended; exitReason says how.
+ */
+bool SandboxPlayer::childExited() {
+    int status;
+    if( child <= 0 ) return true;
+    if( waitpid(child, &status, WNOHANG) != child ) return false;
+    child = -1;
+    exitReason = WIFSIGNALED(status) ? string("died: ") + strsignal(WTERMSIG(status))
+				     : "exited with status " + to_string(WEXITSTATUS(status));
+    return true;
+}
+
+// The next call has moveMillis from now.
+void SandboxPlayer::startClock() {
+    deadline = ShmWait::nowMillis() + limits.moveMillis;
+}
+
+int SandboxPlayer::millisLeft() const {
+    int64_t millis = deadline - ShmWait::nowMillis();
+    return millis > 0 ? millis : 0;
+}
+
+/*
+ * Queues record, waiting (until the deadline) while the ring is full.
+ * Records that need no answer don't wake the child.
+ */
+bool SandboxPlayer::send( SandboxRecord& record, bool wake ) {
+    while( !requests->push(record, min(SliceMillis, millisLeft()), wake) ) {
+	if( childExited() || millisLeft() == 0 ) return false;
+    }
+    return true;
+}
+
+bool SandboxPlayer::receive( SandboxRecord& reply ) {
+    while( !replies->pop(reply, min(SliceMillis, millisLeft())) ) {
+	if( childExited() || millisLeft() == 0 ) return false;
+    }
+    return true;
+}
+
+/*
+ * Sends record and waits for the reply, until the deadline.
+ */
+PackedMessage SandboxPlayer::call( SandboxRecord& record ) {
+    record.haveRng = newGame;
+    record.rng = rng;
+    newGame = false;
+    SandboxRecord reply = SandboxRecord();
+    if( !send(record, true) || !receive(reply) ) {
+	fail(child <= 0 ? exitReason : "took over " + to_string(limits.moveMillis) + " ms");
+	return PackedMessage(INVALID_SHOT);
+    }
+    return reply.msg;
+}
+
+/*
+ * Queues a call that needs no answer.
+ */
+void SandboxPlayer::post( SandboxRecord& record ) {
+    startClock();
+    if( !send(record, false) ) fail(child <= 0 ? exitReason : "didn't take its calls in time");
+}
+
+/**
+ * @brief Starts the round, and a new child if the last one forfeited.
+ */
+void SandboxPlayer::newRound() {
+    if( lost ) {
+	lost = false;
+	start();
+	if( lost ) return;
+    }
+    SandboxRecord record = SandboxRecord();
+    record.call = SandboxRecord::NewRound;
+    record.value = random();
+    newGame = true;
+    post(record);
+}
+
+PackedMessage SandboxPlayer::placePackedShip( int length ) {
+    if( lost ) return PackedMessage( PLACE_SHIP, -1, -1, None, length );
+    SandboxRecord record = SandboxRecord();
+    record.call = SandboxRecord::PlaceShip;
+    record.value = length;
+    startClock();
+    PackedMessage loc = call(record);
+    return lost ? PackedMessage( PLACE_SHIP, -1, -1, None, length ) : loc;
+}
+
+PackedMessage SandboxPlayer::getPackedMove() {
+    if( lost ) return PackedMessage( SHOT, -1, -1 );
+    SandboxRecord record = SandboxRecord();
+    record.call = SandboxRecord::GetMove;
+    startClock();
+    PackedMessage move = call(record);
+    return lost ? PackedMessage( SHOT, -1, -1 ) : move;
+}
+
+void SandboxPlayer::updatePacked( PackedMessage msg ) {
+    if( lost ) return;
+    SandboxRecord record = SandboxRecord();
+    record.call = SandboxRecord::Update;
+    record.msg = msg;
+    post(record);
+}
+
+void SandboxPlayer::updateKill( const ShipKill& kill ) {
+    if( lost ) return;
+    SandboxRecord record = SandboxRecord();
+    record.call = SandboxRecord::Kill;
+    record.kill = kill;
+    post(record);
+}
@@ -0,0 +1,142 @@
+/**
+ * Sandbox.h: runs a player in its own process, with time and memory limits.
+ * Date:      October 2026
+ *
+ * A SandboxPlayer stands in for a player in AIContest. It forks a child
+ * process that makes the real player with the tournament's factory and
+ * serves it with a PlayerHost, which speaks to any player, packed or not.
+ * Controller and child exchange fixed-size binary records (SandboxRecord)
+ * over two ShmRings in shared memory, one each way:
+ *
+ *   - newRound, update and kills are queued without waiting for an answer
+ *     or waking the child,
+ *   - placeShip and getMove wait for the child's reply, at most
+ *     SandboxLimits::moveMillis (counting any updates still queued),
+ *   - the child's address space is capped at SandboxLimits::memoryBytes
+ *     (RLIMIT_AS; Linux doesn't enforce an RSS limit), so a player that
+ *     grows without bound fails its own allocations.
+ *
+ * A child that is late, crashes or runs out of memory is killed and its
+ * player forfeits the game (see PackedPlayerV2::forfeited()); the reason
+ * goes to cerr. The next round starts a new child, so a player that
+ * forfeited has lost what it learned in earlier rounds.
+ *
+ * Children are forked from the controller, so the controller must have no
+ * other threads that could hold a lock at the time (the drivers refuse
+ * --sandbox with --threads). Diagnostics' writer thread is the exception:
+ * the child makes its own, and flushes it before it exits.
+ *
+ * The child seeds its own rand()/random() stream at every round, from the
+ * controller's stream, and packed players still get their Random stream of
+ * the game, so sandboxed matches are repeatable, but players using rand()
+ * don't see the numbers they would see in the controller's process.
+ */
+
+#ifndef SANDBOX_H		// Double inclusion protection
+#define SANDBOX_H
+
+#include <sys/types.h>
+#include <string>
+
+#include "PackedPlayerV2.h"
+#include "PackedMessage.h"
+#include "Random.h"
+#include "ShmRing.h"
+
+using namespace std;
+
+typedef PlayerV2* (*PlayerFactory)( int playerId, int boardSize );
+
+struct SandboxLimits {
+    SandboxLimits() : moveMillis(1000), memoryBytes(256L << 20) {}
+    int moveMillis;	// Longest wait for a move or a placement
+    long memoryBytes;	// Address space of the player's process
+};
+
+/**
+ * @brief One call, or one reply, between controller and child.
+ */
+struct SandboxRecord {
+    enum Call { NewRound, PlaceShip, GetMove, Update, Kill, Reply, Quit };
+
+    int call;
+    int value;		// NewRound: seed for rand(); PlaceShip: ship length
+    int haveRng;	// PlaceShip and GetMove: rng holds a new stream
+    PackedMessage msg;	// Update and Reply
+    ShipKill kill;	// Kill
+    Random rng;		// The player's stream for the game
+};
+
+typedef ShmRing<SandboxRecord, 256> SandboxRing;
+
+/**
+ * @brief The child's side: plays the calls in SandboxRecords on a player.
+ */
+class PlayerHost {
+    public:
+	/**
+	 * @param player Deleted with the host.
+	 */
+	PlayerHost( PlayerV2* player );
+	~PlayerHost();
+
+	/**
+	 * @brief Makes one call. For PlaceShip and GetMove, record becomes the reply.
+	 * @return true if record is now a reply to send back.
+	 */
+	bool handle( SandboxRecord& record );
+
+	/**
+	 * @brief Handles requests until Quit, which is answered once the player is gone.
+	 */
+	void serve( SandboxRing& requests, SandboxRing& replies );
+
+    private:
+	PlayerV2* player;
+	PackedPlayerV2* packed;	// player, if it speaks the packed protocol
+};
+
+class SandboxPlayer: public PackedPlayerV2 {
+    public:
+	/**
+	 * @brief Starts a child that plays getPlayer(playerId, boardSize).
+	 * @param name For messages about the player.
+	 */
+	SandboxPlayer( PlayerFactory getPlayer, int playerId, int boardSize, const string& name,
+	               const SandboxLimits& limits );
+	~SandboxPlayer();
+
+	void newRound() override;
+	PackedMessage placePackedShip( int length ) override;
+	PackedMessage getPackedMove() override;
+	void updatePacked( PackedMessage msg ) override;
+	void updateKill( const ShipKill& kill ) override;
+	bool forfeited() const override { return lost; }
+
+    private:
+	void start();
+	void stop();
+	void fail( const string& why );
+	bool send( SandboxRecord& record, bool wake );
+	bool receive( SandboxRecord& reply );
+	PackedMessage call( SandboxRecord& record );
+	void post( SandboxRecord& record );
+	bool childExited();
+	void startClock();
+	int millisLeft() const;
+
+	PlayerFactory getPlayer;
+	int playerId;
+	string name;
+	const string* opponent;	// Whom the player plays, as set when we were made
+	SandboxLimits limits;
+	pid_t child;
+	SandboxRing* requests;	// To the child
+	SandboxRing* replies;	// From the child
+	bool lost;		// Forfeited this round; the child is gone
+	bool newGame;		// rng not sent to the child yet
+	int64_t deadline;	// Of the call in progress, in ShmWait::nowMillis()
+	string exitReason;	// How the child ended, once childExited()
+};
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * ScanPlayer.cpp: a player that shoots every cell in a fixed order.
+ * Date:           October 2026
+ */
+
+#include "ScanPlayer.h"
+
+ScanPlayer::ScanPlayer( int boardSize, ScanOrder order, ScanTally* tally )
+    :PackedPlayerV2(boardSize)
+{
+    shotOrder(order, boardSize, cells);
+    this->tally = tally;
+    newRound();
+}
+
+void ScanPlayer::shotOrder( ScanOrder order, int boardSize, vector<int>& cells ) {
+    cells.clear();
+    int passes = order == ParityScan ? 2 : 1;
+    for( int pass=0; pass<passes; pass++ ) {
+	for( int cell=0; cell<boardSize*boardSize; cell++ ) {
+	    int colour = (cell/boardSize + cell%boardSize) % 2;
+	    if( passes == 1 || colour == pass ) cells.push_back(cell);
+	}
+    }
+}
+
+void ScanPlayer::newRound() {
+    nextShot = 0;
+    numShipsPlaced = 0;
+}
+
+PackedMessage ScanPlayer::placePackedShip( int length ) {
+    int row, col;
+    Direction dir;
+    placement(numShipsPlaced++, row, col, dir);
+    return PackedMessage( PLACE_SHIP, row, col, dir, length );
+}
+
+/**
+ * @brief The next cell of the order, starting over when they run out.
+ */
+PackedMessage ScanPlayer::getPackedMove() {
+    int cell = cells[nextShot];
+    nextShot = (nextShot+1) % cells.size();
+    return PackedMessage( SHOT, cell / boardSize, cell % boardSize, None, 1 );
+}
+
+void ScanPlayer::updatePacked( PackedMessage msg ) {
+    if( tally && msg.getMessageType() == HIT ) tally->hits++;
+}
+
+void ScanPlayer::updateKill( const ShipKill& ) {
+    if( tally ) {
+	tally->hits++;
+	tally->kills++;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * ScanPlayer.h: a player that shoots every cell in a fixed order.
+ * Date:         October 2026
+ *
+ * The shots never depend on what they hit, so thousands of games between
+ * scanners can be played in lockstep (see BatchSim.h). Ships go where
+ * DumbPlayerV2 puts them, one per row from the top, starting in column 0.
+ * With RowScan the player plays exactly like DumbPlayerV2; ParityScan
+ * sweeps one colour of the checkerboard before the other, like the scan
+ * board of Deng without its targeting.
+ */
+
+#ifndef SCANPLAYER_H		// Double inclusion protection
+#define SCANPLAYER_H
+
+#include <vector>
+
+#include "PackedPlayerV2.h"
+#include "defines.h"
+
+using namespace std;
+
+enum ScanOrder { RowScan, ParityScan, NumScanOrders };
+
+/**
+ * @brief Shots that hit, and shots that sank a ship, over any number of games.
+ */
+struct ScanTally {
+    ScanTally() : hits(0), kills(0) {}
+    long hits;
+    long kills;
+};
+
+class ScanPlayer: public PackedPlayerV2 {
+    public:
+	/**
+	 * @param tally Where hits and kills are counted; null for nowhere.
+	 */
+	ScanPlayer( int boardSize, ScanOrder order, ScanTally* tally = 0 );
+	void newRound() override;
+	PackedMessage placePackedShip(int length) override;
+	PackedMessage getPackedMove() override;
+	void updatePacked(PackedMessage msg) override;
+	void updateKill(const ShipKill& kill) override;
+
+	/**
+	 * @brief The cells (row*boardSize + col) in the order order shoots them.
+	 */
+	static void shotOrder( ScanOrder order, int boardSize, vector<int>& cells );
+
+	/**
+	 * @brief Where ship number ship goes (every scanner places alike).
+	 */
+	static void placement( int ship, int& row, int& col, Direction& dir ) {
+	    row = ship;
+	    col = 0;
+	    dir = Horizontal;
+	}
+
+    private:
+	vector<int> cells;
+	int nextShot;
+	int numShipsPlaced;
+	ScanTally* tally;
+};
+
+#endif
@@ -0,0 +1,17 @@
+/**
+ * ScanPlugin.cpp: the parity scanner (ScanPlayer.h) as a player plugin.
+ * Date:           October 2026
+ *
+ * Built by "make plugins" into plugins/ParityScan.so; a template for
+ * turning any player into a plugin (see PlayerPlugin.h).
+ */
+
+#include "PlayerPlugin.h"
+#include "ScanPlayer.h"
+
+class ParityScanPlayer: public ScanPlayer {
+    public:
+	ParityScanPlayer( int boardSize ) : ScanPlayer(boardSize, ParityScan) {}
+};
+
+PLAYER_PLUGIN( ParityScanPlayer, "Parity Scan", "1.0", MAX_LARGE_BOARD_SIZE )
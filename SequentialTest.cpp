@@ -0,0 +1,85 @@
+/**
+ * SequentialTest.cpp: decides a match as soon as its result is significant.
+ * Date:               October 2026
+ */
+
+#include <cmath>
+#include <iomanip>
+
+#include "SequentialTest.h"
+
+using namespace std;
+
+SequentialTest::SequentialTest( double confidence, double margin ) {
+    this->confidence = confidence;
+    double alpha = 1 - confidence, beta = 1 - confidence;
+    winStep = log(1 + 2*margin);
+    lossStep = log(1 - 2*margin);
+    accept = log((1-beta)/alpha);
+    reject = log(beta/(1-alpha));
+
+    // Two-sided: P(|N(0,1)| > z) = 1 - confidence, by bisection.
+    double low = 0, high = 40;
+    for( int i=0; i<100; i++ ) {
+	double mid = (low+high)/2;
+	if( erfc(mid/sqrt(2.0)) > 1 - confidence ) low = mid;
+	else high = mid;
+    }
+    z = (low+high)/2;
+}
+
+Verdict SequentialTest::decide( int wins1, int wins2 ) const {
+    double up = wins1*winStep + wins2*lossStep;
+    double down = wins1*lossStep + wins2*winStep;
+    if( up >= accept ) return Player1Better;
+    if( down >= accept ) return Player2Better;
+    if( up <= reject && down <= reject ) return PlayersEven;
+    return Undecided;
+}
+
+void SequentialTest::interval( int wins1, int wins2, double& low, double& high ) const {
+    int n = wins1 + wins2;
+    if( n == 0 ) {
+	low = 0;
+	high = 1;
+	return;
+    }
+    double p = double(wins1)/n;
+    double z2n = z*z/n;
+    double centre = (p + z2n/2) / (1 + z2n);
+    double half = z / (1 + z2n) * sqrt(p*(1-p)/n + z2n/(4*n));
+    low = max(0.0, centre - half);
+    high = min(1.0, centre + half);
+}
+
+const char* SequentialTest::verdictName( Verdict verdict ) {
+    switch( verdict ) {
+	case Player1Better: return "player1";
+	case Player2Better: return "player2";
+	case PlayersEven: return "even";
+	default: return "undecided";
+    }
+}
+
+void printVerdict( ostream& out, const string playerNames[2], const SequentialTest& test,
+                   int wins1, int wins2, int rounds, int plannedRounds )
+{
+    Verdict verdict = test.decide(wins1, wins2);
+    double low, high;
+    test.interval(wins1, wins2, low, high);
+
+    if( verdict == Player1Better || verdict == Player2Better ) {
+	out << playerNames[verdict == Player1Better ? 0 : 1] << " is better";
+    } else if( verdict == PlayersEven ) {
+	out << "Even";
+    } else {
+	out << "Undecided";
+    }
+    out << " after " << rounds << " rounds";
+    if( rounds < plannedRounds ) out << " (" << plannedRounds-rounds << " saved)";
+    else if( rounds > plannedRounds ) out << " (" << rounds-plannedRounds << " extra)";
+    out << "; " << fixed << setprecision(1) << 100*test.getConfidence() << "% interval for "
+	<< playerNames[0] << "'s share of decisive rounds: " << setprecision(3) << low << "-" << high << endl;
+    out.unsetf(ios::floatfield);
+    out << setprecision(6);
+}
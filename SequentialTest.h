@@ -0,0 +1,76 @@
+/**
+ * SequentialTest.h: decides a match as soon as its result is significant.
+ * Date:             October 2026
+ *
+ * A match between a much better and a much worse player is clear after a
+ * couple of hundred rounds; playing the rest only costs time. With
+ * --confidence C, MatchRunner checks this test after every round and stops
+ * the match once it is decided.
+ *
+ * Ties carry no information about who is better, so only the decisive
+ * rounds count: p is player 1's share of them. The test runs two Wald
+ * sequential probability ratio tests side by side, each with error rates
+ * alpha = beta = 1 - C:
+ *
+ *   up:   p = 1/2 against p = 1/2 + margin (player 1 better)
+ *   down: p = 1/2 against p = 1/2 - margin (player 2 better)
+ *
+ * If either accepts its alternative, that player is better; if both accept
+ * p = 1/2, the players are even (within the margin). Until then the match
+ * goes on. The log likelihood ratios are linear in the win counts, so a
+ * check is two multiply-adds.
+ *
+ * The interval reported with the verdict is the Wilson score interval for
+ * p at confidence C. It is the usual fixed-sample interval, not corrected
+ * for stopping early.
+ */
+
+#ifndef SEQUENTIALTEST_H		// Double inclusion protection
+#define SEQUENTIALTEST_H
+
+#include <string>
+#include <ostream>
+
+using namespace std;
+
+enum Verdict { Undecided, Player1Better, Player2Better, PlayersEven };
+
+class SequentialTest {
+  public:
+    /**
+     * @param confidence In (0.5, 1), e.g. 0.95.
+     * @param margin Smallest difference from p = 1/2 worth finding, in (0, 0.5).
+     */
+    SequentialTest( double confidence, double margin );
+
+    Verdict decide( int wins1, int wins2 ) const;
+
+    /**
+     * @brief The interval for player 1's share of the decisive rounds.
+     */
+    void interval( int wins1, int wins2, double& low, double& high ) const;
+
+    double getConfidence() const { return confidence; }
+
+    /**
+     * @brief "undecided", "player1", "player2" or "even", as in CSV and JSON output.
+     */
+    static const char* verdictName( Verdict verdict );
+
+  private:
+    double confidence;
+    double winStep;	// log((1/2 + margin) / (1/2)): an up-test win, a down-test loss
+    double lossStep;	// log((1/2 - margin) / (1/2))
+    double accept;	// log((1-beta)/alpha): accept the alternative at or above this
+    double reject;	// log(beta/(1-alpha)): accept p = 1/2 at or below this
+    double z;		// Normal quantile for the interval
+};
+
+/**
+ * @brief Prints a match's verdict, rounds played against plannedRounds, and
+ * the interval, on one line.
+ */
+void printVerdict( ostream& out, const string playerNames[2], const SequentialTest& test,
+                   int wins1, int wins2, int rounds, int plannedRounds );
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * ShmRing.cpp: futex waits and shared memory for ShmRing.
+ * Date:        October 2026
+ */
+
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "ShmRing.h"
+
+using namespace std;
+
+namespace ShmWait {
+    const int Spins = 2000;	// About a microsecond or two of pause instructions
+
+    void wait( atomic<uint32_t>& word, uint32_t expected, int millis ) {
+	struct timespec timeout;
+	timeout.tv_sec = millis / 1000;
+	timeout.tv_nsec = (millis % 1000) * 1000000L;
+	syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT, expected, millis < 0 ? 0 : &timeout, 0, 0);
+    }
+
+    void wake( atomic<uint32_t>& word, int count ) {
+	syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE, count, 0, 0, 0);
+    }
+
+    int spinCount() {
+	static const int spins = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? Spins : 0;
+	return spins;
+    }
+
+    void* mapShared( size_t bytes ) {
+	void* memory = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	return memory == MAP_FAILED ? 0 : memory;
+    }
+
+    void unmapShared( void* memory, size_t bytes ) {
+	munmap(memory, bytes);
+    }
+
+    int64_t nowMillis() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return int64_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * ShmRing.h: a single-producer, single-consumer ring of fixed-size records
+ *            in memory shared between processes.
+ * Date:      October 2026
+ *
+ * The ring lives in an anonymous shared mapping made before fork(), so
+ * parent and child see the same one. head and tail count records pushed and
+ * popped; each is written by one side only, so the ring needs no locks:
+ * the producer fills the slot, then publishes it with a release store of
+ * head, and the consumer reads the slot after an acquire load of head (and
+ * the other way round for tail).
+ *
+ * A side that finds the ring empty (or full) spins briefly, then sleeps on
+ * a futex on the counter it waits for; the other side wakes it only if its
+ * waiting flag is up, so a ring that is never waited on makes no system
+ * calls at all. With one CPU there is nobody to spin for, so waits go
+ * straight to the futex.
+ *
+ * push() can leave the consumer asleep (wake = false): records that need no
+ * answer pile up and the consumer gets them all with the next record that
+ * does, saving a wake-up (and, on one CPU, a context switch) per record.
+ */
+
+#ifndef SHMRING_H		// Double inclusion protection
+#define SHMRING_H
+
+#include <stdint.h>
+#include <atomic>
+#include <new>
+
+using namespace std;
+
+namespace ShmWait {
+    /**
+     * @brief Sleeps while *word == expected, at most millis ms (< 0: no limit).
+     * Shared (not process private), so it works across fork().
+     */
+    void wait( atomic<uint32_t>& word, uint32_t expected, int millis );
+    void wake( atomic<uint32_t>& word, int count = 1 );	// Wakes up to count sleepers
+
+    /**
+     * @brief Spins before sleeping: 0 on a single CPU.
+     */
+    int spinCount();
+
+    /**
+     * @brief One turn of a spin loop: the pause hint on x86, elsewhere just
+     * a compiler barrier, so the loop still reloads what it waits on.
+     */
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#else
+	atomic_signal_fence(memory_order_seq_cst);
+#endif
+    }
+
+    void* mapShared( size_t bytes );
+    void unmapShared( void* memory, size_t bytes );
+
+    // Milliseconds on the monotonic clock, for wait budgets.
+    int64_t nowMillis();
+}
+
+template<class Record, int Capacity>
+class ShmRing {
+  public:
+    /**
+     * @brief A new, empty ring in shared memory; null if there is none.
+     */
+    static ShmRing* create() {
+	void* memory = ShmWait::mapShared(sizeof(ShmRing));
+	return memory ? new(memory) ShmRing() : 0;
+    }
+
+    static void destroy( ShmRing* ring ) {
+	if( !ring ) return;
+	ring->~ShmRing();
+	ShmWait::unmapShared(ring, sizeof(ShmRing));
+    }
+
+    /**
+     * @brief Adds record, waiting at most millis ms (< 0: no limit) for room.
+     * @param wake Wake the consumer if it sleeps.
+     * @return false if there was no room in time.
+     */
+    bool push( const Record& record, int millis, bool wake = true ) {
+	uint32_t h = head.load(memory_order_relaxed);
+	if( h - tail.load(memory_order_acquire) == Capacity ) {
+	    wakeConsumer();	// It has to make the room
+	    if( !await(tail, h - Capacity, producerWaiting, millis) ) return false;
+	}
+	slots[h % Capacity] = record;
+	head.store(h+1, memory_order_seq_cst);
+	if( wake ) wakeConsumer();
+	return true;
+    }
+
+    /**
+     * @brief Takes the oldest record, waiting at most millis ms (< 0: no limit).
+     * @return false if none came in time.
+     */
+    bool pop( Record& record, int millis ) {
+	uint32_t t = tail.load(memory_order_relaxed);
+	if( head.load(memory_order_acquire) == t ) {
+	    if( !await(head, t, consumerWaiting, millis) ) return false;
+	}
+	record = slots[t % Capacity];
+	tail.store(t+1, memory_order_seq_cst);
+	if( producerWaiting.load(memory_order_seq_cst) ) ShmWait::wake(tail);
+	return true;
+    }
+
+  private:
+    ShmRing() : head(0), tail(0), consumerWaiting(0), producerWaiting(0) {}
+
+    void wakeConsumer() {
+	if( consumerWaiting.load(memory_order_seq_cst) ) ShmWait::wake(head);
+    }
+
+    /*
+     * Waits until counter moves off stuck: spins, then raises flag and
+     * sleeps on the counter's futex.
+     */
+    bool await( atomic<uint32_t>& counter, uint32_t stuck, atomic<uint32_t>& flag, int millis ) {
+	for( int spin=ShmWait::spinCount(); spin>0; spin-- ) {
+	    if( counter.load(memory_order_acquire) != stuck ) return true;
+	    ShmWait::cpuRelax();
+	}
+	int64_t deadline = ShmWait::nowMillis() + millis;
+	for(;;) {
+	    flag.store(1, memory_order_seq_cst);
+	    // Checked again after raising the flag, or a wake-up could be missed.
+	    if( counter.load(memory_order_seq_cst) != stuck ) break;
+	    int left = millis < 0 ? -1 : int(deadline - ShmWait::nowMillis());
+	    if( millis >= 0 && left <= 0 ) {
+		flag.store(0, memory_order_relaxed);
+		return counter.load(memory_order_acquire) != stuck;
+	    }
+	    ShmWait::wait(counter, stuck, left);
+	}
+	flag.store(0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_acquire);
+	return true;
+    }
+
+    // Each counter on its own cache line, so the sides don't share lines.
+    alignas(64) atomic<uint32_t> head;		// Records pushed; written by the producer
+    alignas(64) atomic<uint32_t> tail;		// Records popped; written by the consumer
+    alignas(64) atomic<uint32_t> consumerWaiting;	// Consumer sleeps on head
+    alignas(64) atomic<uint32_t> producerWaiting;	// Producer sleeps on tail
+    alignas(64) Record slots[Capacity];
+};
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * Tablebase.cpp: perfect shots for the small boards, looked up in a file the
+ *                solver (solve.cpp) wrote.
+ * Date:          October 2026
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Tablebase.h"
+
+namespace {
+    const char Magic[4] = { 'B', 'S', 'T', 'B' };
+    const int Version = 1;
+    const size_t HeaderSize = 24;
+
+    const int BlockedShift = 0;
+    const int HitsShift = 25;
+    const int FleetShift = 50;
+    const int BoardShift = 56;
+}
+
+BoardSymmetry::BoardSymmetry( int boardSize ) {
+    this->boardSize = boardSize;
+    memset(bytes, 0, sizeof(bytes));
+    for( int symmetry=0; symmetry<Count; symmetry++ ) {
+	for( int row=0; row<boardSize; row++ ) {
+	    for( int col=0; col<boardSize; col++ ) {
+		int newRow = symmetry & 2 ? boardSize-1 - row : row;
+		int newCol = symmetry & 1 ? boardSize-1 - col : col;
+		if( symmetry & 4 ) {
+		    int swap = newRow;
+		    newRow = newCol;
+		    newCol = swap;
+		}
+		int from = row*boardSize + col;
+		int to = newRow*boardSize + newCol;
+		cells[symmetry][from] = to;
+		inverse[symmetry][to] = from;
+	    }
+	}
+	for( int i=0; i<ByteTables; i++ ) {
+	    for( int byte=0; byte<256; byte++ ) {
+		for( int bit=0; bit<8; bit++ ) {
+		    int from = 8*i + bit;
+		    if( (byte >> bit & 1) && from < boardSize*boardSize ) {
+			bytes[symmetry][i][byte] |= uint32_t(1) << cells[symmetry][from];
+		    }
+		}
+	    }
+	}
+    }
+}
+
+int Tablebase::fleetCode( const int shipsLeft[] ) {
+    int code = 0;
+    for( int length=MIN_SHIP_SIZE; length<=MAX_SHIP_SIZE; length++ ) {
+	code |= shipsLeft[length] << 2*(length-MIN_SHIP_SIZE);
+    }
+    return code;
+}
+
+TablebaseKey Tablebase::key( const BoardSymmetry& symmetries, int fleet, Bitboard64 blocked, Bitboard64 hits,
+			     int& symmetry ) {
+    TablebaseKey common = TablebaseKey(fleet) << FleetShift
+			| TablebaseKey(symmetries.size() - MinBoardSize) << BoardShift;
+    TablebaseKey best = 0;
+    for( int i=0; i<BoardSymmetry::Count; i++ ) {
+	TablebaseKey key = common | symmetries.mask(i, blocked).bits << BlockedShift
+			 | symmetries.mask(i, hits).bits << HitsShift;
+	if( i == 0 || key < best ) {
+	    best = key;
+	    symmetry = i;
+	}
+    }
+    return best;
+}
+
+Tablebase::Tablebase() {
+    mapping = 0;
+    mappedBytes = 0;
+    slots = 0;
+    capacity = 0;
+    entries = 0;
+}
+
+Tablebase::~Tablebase() {
+    close();
+}
+
+bool Tablebase::open( const string& fileName ) {
+    close();
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if( fd < 0 ) {
+	problem = "can't open " + fileName;
+	return false;
+    }
+    struct stat info;
+    void* memory = MAP_FAILED;
+    if( fstat(fd, &info) == 0 && size_t(info.st_size) >= HeaderSize ) {
+	memory = mmap(0, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);	// The mapping keeps the file
+    if( memory == MAP_FAILED ) {
+	problem = fileName + " is not a tablebase";
+	return false;
+    }
+
+    const unsigned char* header = (const unsigned char*)memory;
+    uint64_t fileCapacity, fileEntries;
+    memcpy(&fileCapacity, header + 8, 8);
+    memcpy(&fileEntries, header + 16, 8);
+    if( memcmp(header, Magic, 4) != 0 ) {
+	problem = fileName + " is not a tablebase";
+    } else if( header[4] != Version ) {
+	problem = fileName + " is a version " + to_string(header[4]) + " tablebase, expected "
+		  + to_string(Version);
+    } else if( fileCapacity == 0 || (fileCapacity & (fileCapacity-1)) != 0 || fileEntries >= fileCapacity
+	       || size_t(info.st_size) != HeaderSize + 8*fileCapacity ) {
+	problem = fileName + " is damaged";
+    }
+    if( !problem.empty() ) {
+	munmap(memory, info.st_size);
+	return false;
+    }
+    mapping = memory;
+    mappedBytes = info.st_size;
+    slots = (const uint64_t*)(header + HeaderSize);
+    capacity = fileCapacity;
+    entries = fileEntries;
+    return true;
+}
+
+void Tablebase::close() {
+    if( mapping ) munmap(mapping, mappedBytes);
+    mapping = 0;
+    mappedBytes = 0;
+    slots = 0;
+    capacity = 0;
+    entries = 0;
+    problem = "";
+}
+
+bool Tablebase::write( const string& fileName, const vector<TablebaseKey>& keys, const vector<int>& cells ) {
+    uint64_t tableCapacity = 16;
+    while( tableCapacity < 2*keys.size() ) tableCapacity *= 2;
+    vector<uint64_t> table(tableCapacity, 0);
+    for( size_t i=0; i<keys.size(); i++ ) {
+	size_t slot = home(keys[i], tableCapacity);
+	while( table[slot] != 0 ) slot = (slot+1) & (tableCapacity-1);
+	table[slot] = keys[i] | uint64_t(cells[i]+1) << CellShift;
+    }
+
+    unsigned char header[HeaderSize] = { 0 };
+    memcpy(header, Magic, 4);
+    header[4] = Version;
+    uint64_t numEntries = keys.size();
+    memcpy(header + 8, &tableCapacity, 8);
+    memcpy(header + 16, &numEntries, 8);
+
+    FILE* file = fopen(fileName.c_str(), "wb");
+    if( !file ) return false;
+    bool ok = fwrite(header, 1, HeaderSize, file) == HeaderSize
+	      && fwrite(&table[0], 8, tableCapacity, file) == tableCapacity;
+    return fclose(file) == 0 && ok;
+}
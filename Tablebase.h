@@ -0,0 +1,156 @@
+/**
+ * Tablebase.h: perfect shots for the small boards, looked up in a file the
+ *              solver (solve.cpp) wrote.
+ * Date:        October 2026
+ *
+ * On boards of 3x3 to 5x5 a player knows, at any point of a round:
+ *
+ *   blocked   cells no ship still afloat can be on: misses and sunk ships,
+ *   hits      hits on ships that are not sunk yet,
+ *   fleet     how many ships of each length are still afloat.
+ *
+ * The placements of the fleet that fit what it knows only depend on these,
+ * not on the order of the shots, so they are the whole state. A TablebaseKey
+ * packs them into one word:
+ *
+ *   bits  0-24   blocked, cell = row*boardSize + col
+ *   bits 25-49   hits
+ *   bits 50-55   fleet: ships of length 3, 4 and 5 afloat, 2 bits each
+ *   bits 56-57   boardSize - 3
+ *
+ * A state and its 7 mirror images (BoardSymmetry) have the same best shot,
+ * mirrored, so the table keeps only the one with the smallest key.
+ *
+ * File layout (integers little endian):
+ *
+ *   "BSTB" version(1) 0 0 0
+ *   capacity(8) entries(8)
+ *   capacity x slot(8)      0 = empty, else key | (cell+1) << CellShift
+ *
+ * The slots are an open addressed hash table: a key lives in the first empty
+ * slot at or after Tablebase::home(key), wrapping around. capacity is a power
+ * of two at least twice entries, so a lookup reads a slot or two of the
+ * mapped file.
+ */
+
+#ifndef TABLEBASE_H		// Double inclusion protection
+#define TABLEBASE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Bitboard.h"
+#include "defines.h"
+
+using namespace std;
+
+typedef uint64_t TablebaseKey;
+
+/**
+ * @brief The 8 ways to turn or mirror a square board: bit 0 mirrors the
+ * columns, bit 1 the rows, bit 2 swaps rows and columns (in that order).
+ * Symmetry 0 leaves the board as it is.
+ */
+class BoardSymmetry {
+    public:
+	static const int Count = 8;
+
+	BoardSymmetry( int boardSize );
+
+	int size() const { return boardSize; }
+	int cell( int symmetry, int cell ) const { return cells[symmetry][cell]; }
+
+	/**
+	 * @brief The cell that symmetry takes to the given one.
+	 */
+	int inverseCell( int symmetry, int cell ) const { return inverse[symmetry][cell]; }
+
+	Bitboard64 mask( int symmetry, Bitboard64 cells ) const {
+	    uint64_t bits = 0;
+	    for( int i=0; i<ByteTables; i++ ) {
+		bits |= bytes[symmetry][i][(cells.bits >> 8*i) & 0xff];
+	    }
+	    return Bitboard64(bits);
+	}
+
+    private:
+	static const int MaxCells = 25;
+	static const int ByteTables = (MaxCells+7) / 8;
+
+	int boardSize;
+	unsigned char cells[Count][MaxCells];
+	unsigned char inverse[Count][MaxCells];
+	uint32_t bytes[Count][ByteTables][256];		// Images of each byte of a mask
+};
+
+class Tablebase {
+    public:
+	static const int MinBoardSize = 3;
+	static const int MaxBoardSize = 5;
+	static const int CellShift = 58;	// Slots keep the cell above the key
+
+	/**
+	 * @brief Packs the fleet afloat, shipsLeft[length] for lengths
+	 * MIN_SHIP_SIZE to MAX_SHIP_SIZE (at most 3 each), for key().
+	 */
+	static int fleetCode( const int shipsLeft[] );
+
+	/**
+	 * @brief The key of the mirror image of the state with the smallest key.
+	 * @param symmetry Set to the symmetry that takes the board to that image.
+	 */
+	static TablebaseKey key( const BoardSymmetry& symmetries, int fleet, Bitboard64 blocked, Bitboard64 hits,
+				 int& symmetry );
+
+	static size_t home( TablebaseKey key, size_t capacity ) {
+	    return (key * 0x9E3779B97F4A7C15ull) >> 32 & (capacity-1);
+	}
+
+	Tablebase();
+	~Tablebase();
+
+	/**
+	 * @brief Maps the file read-only and checks its header.
+	 * @return false (with error() saying why) if it isn't a tablebase.
+	 */
+	bool open( const string& fileName );
+	void close();
+	bool isOpen() const { return slots != 0; }
+
+	/**
+	 * @brief The best shot in the state key() gave, in that key's mirror
+	 * image of the board; -1 if the state is not in the table.
+	 */
+	int lookup( TablebaseKey key ) const {
+	    if( !slots ) return -1;
+	    for( size_t slot = home(key, capacity); slots[slot] != 0; slot = (slot+1) & (capacity-1) ) {
+		if( (slots[slot] & KeyMask) == key ) return int(slots[slot] >> CellShift) - 1;
+	    }
+	    return -1;
+	}
+
+	size_t size() const { return entries; }
+	const string& error() const { return problem; }
+
+	/**
+	 * @brief Writes a table of the given states and shots (cells of the
+	 * keys' mirror images).
+	 */
+	static bool write( const string& fileName, const vector<TablebaseKey>& keys, const vector<int>& cells );
+
+    private:
+	static const uint64_t KeyMask = (uint64_t(1) << CellShift) - 1;
+
+	Tablebase( const Tablebase& );
+	void operator=( const Tablebase& );
+
+	void* mapping;
+	size_t mappedBytes;
+	const uint64_t* slots;	// Into mapping; 0 if no table is open
+	size_t capacity;
+	size_t entries;
+	string problem;
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * TablebasePlayer.cpp: perfect shooting on the small boards, from the
+ *                      tablebase that solve writes (Tablebase.h).
+ * Date:                October 2026
+ */
+
+#include <iostream>
+
+#include "TablebasePlayer.h"
+
+const char* const TablebasePlayer::DefaultFile = "tablebase.bin";
+
+namespace {
+    const BoardSymmetry* symmetriesOf( int boardSize ) {
+	static const BoardSymmetry symmetries[] = { BoardSymmetry(3), BoardSymmetry(4), BoardSymmetry(5) };
+	if( boardSize < Tablebase::MinBoardSize || boardSize > Tablebase::MaxBoardSize ) return 0;
+	return &symmetries[boardSize - Tablebase::MinBoardSize];
+    }
+
+    const Tablebase* openTable() {
+	Tablebase* table = new Tablebase;	// Mapped for the rest of the run
+	if( !table->open(TablebasePlayer::DefaultFile) ) {
+	    cerr << "Tablebase Player: " << table->error() << ", shooting by density instead (make tablebase)"
+		 << endl;
+	}
+	return table;
+    }
+}
+
+TablebasePlayer::TablebasePlayer( int boardSize )
+    :DensityPlayer(boardSize)
+{
+    symmetries = symmetriesOf(boardSize);
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) shipsLeft[length] = 0;
+}
+
+TablebasePlayer::~TablebasePlayer() {
+}
+
+const Tablebase& TablebasePlayer::table() {
+    static const Tablebase* table = openTable();
+    return *table;
+}
+
+void TablebasePlayer::newRound() {
+    DensityPlayer::newRound();
+    blocked = Bitboard64();
+    hits = Bitboard64();
+    for( int length=0; length<=MAX_SHIP_SIZE; length++ ) shipsLeft[length] = 0;
+}
+
+/**
+ * @brief Learns the fleet from our own ships: both fleets are the same.
+ */
+PackedMessage TablebasePlayer::placePackedShip( int length ) {
+    if( length >= MIN_SHIP_SIZE && length <= MAX_SHIP_SIZE ) shipsLeft[length]++;
+    return DensityPlayer::placePackedShip(length);
+}
+
+PackedMessage TablebasePlayer::getPackedMove() {
+    if( symmetries && table().isOpen() ) {
+	int symmetry;
+	TablebaseKey key = Tablebase::key(*symmetries, Tablebase::fleetCode(shipsLeft), blocked, hits, symmetry);
+	int cell = table().lookup(key);
+	if( cell >= 0 ) {
+	    cell = symmetries->inverseCell(symmetry, cell);
+	    return PackedMessage( SHOT, cell / boardSize, cell % boardSize, None, 1 );
+	}
+    }
+    return DensityPlayer::getPackedMove();
+}
+
+void TablebasePlayer::updatePacked( PackedMessage msg ) {
+    int cell = msg.getRow()*boardSize + msg.getCol();
+    switch( msg.getMessageType() ) {
+	case MISS:
+	    if( symmetries ) blocked.set(cell);
+	    break;
+	case HIT:
+	    if( symmetries ) hits.set(cell);
+	    break;
+	default:
+	    break;
+    }
+    DensityPlayer::updatePacked(msg);
+}
+
+void TablebasePlayer::updateKill( const ShipKill& kill ) {
+    if( symmetries ) {
+	Bitboard64 cells(kill.cells.lo);	// Boards up to 5x5 fit the low word
+	hits = hits.andNot(cells);
+	blocked |= cells;
+	if( kill.length() <= MAX_SHIP_SIZE && shipsLeft[kill.length()] > 0 ) shipsLeft[kill.length()]--;
+    }
+    DensityPlayer::updateKill(kill);
+}
@@ -0,0 +1,49 @@
+/**
+ * TablebasePlayer.h: perfect shooting on the small boards, from the
+ *                    tablebase that solve writes (Tablebase.h).
+ * Date:              October 2026
+ *
+ * On boards of 3x3 to 5x5 every shot is looked up in tablebase.bin: the
+ * shot that sinks the fleet in the fewest shots on average, wherever the
+ * opponent put it. That makes the player the baseline to hold the others'
+ * shooting against (./bench tablebase). On larger boards, without the file
+ * or in a state the table doesn't have, it shoots like the DensityPlayer
+ * it is built on; ships are placed the same way.
+ */
+
+#ifndef TABLEBASEPLAYER_H		// Double inclusion protection
+#define TABLEBASEPLAYER_H
+
+using namespace std;
+
+#include "DensityPlayer.h"
+#include "Tablebase.h"
+#include "Bitboard.h"
+#include "defines.h"
+
+class TablebasePlayer: public DensityPlayer {
+    public:
+	static const char* const DefaultFile;	// "tablebase.bin"
+
+	TablebasePlayer( int boardSize );
+	~TablebasePlayer();
+	void newRound() override;
+	PackedMessage placePackedShip(int length) override;
+	PackedMessage getPackedMove() override;
+	void updatePacked(PackedMessage msg) override;
+	void updateKill(const ShipKill& kill) override;
+
+	/**
+	 * @brief The table every TablebasePlayer reads, DefaultFile mapped the
+	 * first time it is needed; not open if that failed.
+	 */
+	static const Tablebase& table();
+
+    private:
+	const BoardSymmetry* symmetries;	// 0 if the board is not in the table's range
+	Bitboard64 blocked;	// Misses and sunk ships
+	Bitboard64 hits;	// Hits on ships that are not sunk yet
+	int shipsLeft[MAX_SHIP_SIZE+1];
+};
+
+#endif
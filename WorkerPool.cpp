@@ -0,0 +1,82 @@
+/**
+ * WorkerPool.cpp: threads that share out the work of one move.
+ * Date:           October 2026
+ */
+
+#include <chrono>
+
+#include "WorkerPool.h"
+#include "ShmRing.h"
+
+WorkerPool::WorkerPool( int threads )
+    : task(0), stopping(false)
+{
+    generation.value = workersAsleep.value = pending.value = callerAsleep.value = 0;
+    if( threads <= 0 ) threads = thread::hardware_concurrency();
+    if( threads < 1 ) threads = 1;
+    if( threads > MaxThreads ) threads = MaxThreads;
+    this->threads = threads;
+    for( int part=1; part<threads; part++ ) {
+	workers[part-1] = thread(&WorkerPool::work, this, part);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stopping = true;
+    generation.value.fetch_add(1, memory_order_seq_cst);
+    ShmWait::wake(generation.value, MaxThreads);
+    for( int part=1; part<threads; part++ ) workers[part-1].join();
+}
+
+void WorkerPool::run( ParallelTask& task ) {
+    if( threads == 1 ) {
+	task.runPart(0, 1);
+	return;
+    }
+    this->task = &task;
+    pending.value.store(threads-1, memory_order_relaxed);
+    generation.value.fetch_add(1, memory_order_seq_cst);	// Publishes task and pending
+    if( workersAsleep.value.load(memory_order_seq_cst) ) ShmWait::wake(generation.value, MaxThreads);
+
+    task.runPart(0, threads);
+    for( uint32_t left; (left = pending.value.load(memory_order_acquire)) != 0; ) {
+	await(pending.value, left, callerAsleep.value);
+    }
+}
+
+void WorkerPool::work( int part ) {
+    uint32_t seen = 0;
+    for(;;) {
+	await(generation.value, seen, workersAsleep.value);
+	seen = generation.value.load(memory_order_acquire);
+	if( stopping ) return;
+	task->runPart(part, threads);
+	if( pending.value.fetch_sub(1, memory_order_seq_cst) == 1 && callerAsleep.value.load(memory_order_seq_cst) ) {
+	    ShmWait::wake(pending.value);
+	}
+    }
+}
+
+/*
+ * Waits until counter moves off stuck: spins for SpinMicros, then counts
+ * itself in sleepers and sleeps on the counter's futex.
+ */
+void WorkerPool::await( atomic<uint32_t>& counter, uint32_t stuck, atomic<uint32_t>& sleepers ) {
+    if( counter.load(memory_order_acquire) != stuck ) return;
+    if( ShmWait::spinCount() > 0 ) {
+	typedef chrono::steady_clock Clock;
+	Clock::time_point deadline = Clock::now() + chrono::microseconds(SpinMicros);
+	do {
+	    for( int spin=0; spin<64; spin++ ) {
+		if( counter.load(memory_order_acquire) != stuck ) return;
+		ShmWait::cpuRelax();
+	    }
+	} while( Clock::now() < deadline );
+    }
+    sleepers.fetch_add(1, memory_order_seq_cst);
+    // Checked again after counting in, or a wake-up could be missed.
+    while( counter.load(memory_order_seq_cst) == stuck ) {
+	ShmWait::wait(counter, stuck, -1);
+    }
+    sleepers.fetch_sub(1, memory_order_relaxed);
+}
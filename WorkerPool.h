@@ -0,0 +1,88 @@
+/**
+ * WorkerPool.h: threads that share out the work of one move.
+ * Date:         October 2026
+ *
+ * A player that wants more than one core for a move makes a pool in its
+ * constructor. Each run() hands the same ParallelTask to every thread,
+ * the calling one included, as parts 0 (the caller) to size()-1, and
+ * returns when every part is done. The threads live as long as the pool,
+ * so a move costs a wake-up, not a thread start.
+ *
+ * Between runs the workers spin for SpinMicros, so the next move of a
+ * match finds them awake, then sleep on a futex (ShmWait); the caller waits
+ * for the last part the same way. A pool that is never asleep makes no
+ * system calls. With one CPU there is nobody to spin for: waits sleep
+ * straight away, and a pool of one thread just calls the task.
+ *
+ * A pool of n threads starts n-1 of them, in the constructor; run()
+ * allocates nothing.
+ */
+
+#ifndef WORKERPOOL_H		// Double inclusion protection
+#define WORKERPOOL_H
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief Work that a WorkerPool splits between its threads.
+ */
+class ParallelTask {
+    public:
+	virtual ~ParallelTask() {}
+
+	/**
+	 * @brief Does part of the work, on its own thread: parts runs at once.
+	 */
+	virtual void runPart( int part, int parts ) = 0;
+};
+
+class WorkerPool {
+    public:
+	static const int MaxThreads = 16;
+	static const int SpinMicros = 50;	// Spinning before a wait sleeps
+
+	/**
+	 * @brief A pool of threads threads in all, counting the caller of run():
+	 * 1 to MaxThreads, 0 for one per CPU.
+	 */
+	WorkerPool( int threads );
+	~WorkerPool();
+
+	int size() const { return threads; }
+
+	/**
+	 * @brief Runs every part of the task and waits for them all.
+	 */
+	void run( ParallelTask& task );
+
+    private:
+	WorkerPool( const WorkerPool& );
+	void operator=( const WorkerPool& );
+
+	void work( int part );
+	static void await( atomic<uint32_t>& counter, uint32_t stuck, atomic<uint32_t>& sleepers );
+
+	int threads;
+	thread workers[MaxThreads-1];
+	ParallelTask* task;	// Set before each generation starts
+	bool stopping;
+
+	// A counter with a cache line to itself, so the sides don't share lines.
+	// Padded, not alignas(64): players that own a pool are made with plain new.
+	struct Counter {
+	    atomic<uint32_t> value;
+	    char padding[64 - sizeof(atomic<uint32_t>)];
+	};
+
+	char padding[64];
+	Counter generation;	// Runs started; workers sleep on it
+	Counter workersAsleep;
+	Counter pending;	// Parts of this run not done yet; the caller sleeps on it
+	Counter callerAsleep;
+};
+
+#endif
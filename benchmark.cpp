@@ -0,0 +1,868 @@
+/**
+ * @file benchmark.cpp
+ * @date October 2026
+ * Micro benchmarks for the game engine pieces.
+ *
+ * Run as './bench' for every benchmark or './bench <name> ...' for a subset.
+ * Every benchmark prints one line per case with the time per operation.
+ * Those that check one implementation against another (board, sized, large,
+ * batch) count mismatches, alloc and ratings check their results too; bench
+ * exits with 1 if any check failed.
+ *
+ *   board    BoardV3 (bitboard) against ReferenceBoardV3 (char arrays):
+ *            plays the same random games on both, checks that every answer
+ *            matches, and times full games on each.
+ *   sized    Board<N> against BoardV3 the same way, per board size, called
+ *            directly and through GameBoard* as AIContest calls them.
+ *   large    LargeBoard against BoardV3 the same way up to 10x10, then its
+ *            cost per shot and per cell on boards up to 128x128.
+ *   message  One shot's worth of protocol traffic (a move out, a result
+ *            back) with Message against PackedMessage.
+ *   random   Random::below() against rand() % n.
+ *   density  Cost of getMove() and shots per game for DensityPlayer, with
+ *            Deng's parity scan as the baseline.
+ *   tablebase The same on 3x3 to 5x5 with TablebasePlayer, whose shots per
+ *            game are the fewest possible on average (needs tablebase.bin).
+ *   montecarlo MonteCarloPlayer on 10x10 with a few budgets per shot:
+ *            ns per move, shots per game and layouts sampled per second,
+ *            against DensityPlayer; then at 50us on 1, 2 and 4 threads,
+ *            and the cost of a WorkerPool fork/join with nothing to do.
+ *   models   The opponent model store (OpponentModels): a lock-free read,
+ *            a locked commit (with its heap allocations), and making a
+ *            Deng with and without a stored model to start from.
+ *   alloc    Heap allocations per round of a match, counted by the
+ *            operator new below, after the first round of the job; any at
+ *            all is a failed check.
+ *   batch    Matches between scanners (DumbPlayerV2's row scan against a
+ *            parity scan) through MatchRunner and through BatchSim with each
+ *            kernel: checks that the stats agree and times a game on each.
+ *   ratings  RatingTable::addMatch() for one-sided matches of 100 and 1000
+ *            rounds, 20 in a row between the same two players: the cost
+ *            of each, and a check that the winner stays ahead with its
+ *            deviation lower after the last than after the first.
+ *   remote   A getMove() round trip and a queued update to a ScanPlayer in
+ *            a sandbox process (ShmRing transport), against calling it
+ *            through its vtable; p50/p99 per round trip.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <unistd.h>
+
+#include "defines.h"
+#include "BoardV3.h"
+#include "Board.h"
+#include "LargeBoard.h"
+#include "ReferenceBoardV3.h"
+#include "Message.h"
+#include "PackedMessage.h"
+#include "Random.h"
+#include "DensityPlayer.h"
+#include "TablebasePlayer.h"
+#include "MonteCarloPlayer.h"
+#include "WorkerPool.h"
+#include "OpponentModels.h"
+#include "Deng.h"
+#include "DumbPlayerV2.h"
+#include "ScanPlayer.h"
+#include "BatchSim.h"
+#include "MatchRunner.h"
+#include "Sandbox.h"
+#include "PlayerTiming.h"
+#include "Diagnostics.h"
+#include "Ratings.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+/*
+ * Test hook for the alloc benchmark: counts every operator new in the
+ * program (operator new[] and the nothrow forms come through here too).
+ */
+static atomic<long> allocations(0);
+
+void* operator new( size_t size ) {
+    allocations++;
+    void* memory = malloc(size ? size : 1);
+    if( !memory ) throw bad_alloc();
+    return memory;
+}
+
+void operator delete( void* memory ) noexcept {
+    free(memory);
+}
+
+/*
+ * Mismatches the differential checks found and other failed checks, over
+ * every benchmark run; main() fails if there were any.
+ */
+static long failedChecks = 0;
+
+static double nanosSince( Clock::time_point start, long operations ) {
+    chrono::duration<double, nano> elapsed = Clock::now() - start;
+    return elapsed.count() / operations;
+}
+
+/*
+ * Small deterministic generator so every run benchmarks the same games.
+ */
+static uint64_t benchState = 0x9E3779B97F4A7C15ULL;
+static uint32_t benchRandom( uint32_t bound ) {
+    benchState ^= benchState << 13;
+    benchState ^= benchState >> 7;
+    benchState ^= benchState << 17;
+    return uint32_t(benchState % bound);
+}
+
+/*
+ * Places boardSize-2 random ships (capped at 6, like AIContest) on both boards
+ * and records the placements so the timing loops can replay them.
+ */
+struct GameSetup {
+    int numShips;
+    int row[6], col[6], length[6];
+    Direction dir[6];
+    int shotOrder[BoardV3::MaxBoardSize*BoardV3::MaxBoardSize];
+};
+
+static void makeGame( int boardSize, GameSetup& game ) {
+    game.numShips = boardSize-2 > 6 ? 6 : boardSize-2;
+    for(int i=0; i<game.numShips; i++) {
+	game.length[i] = benchRandom(3) + 3;
+	game.dir[i] = benchRandom(2) ? Horizontal : Vertical;
+	game.row[i] = benchRandom(boardSize);
+	game.col[i] = benchRandom(boardSize);
+    }
+    int cells = boardSize*boardSize;
+    for(int i=0; i<cells; i++) game.shotOrder[i] = i;
+    for(int i=cells-1; i>0; i--) {
+	int j = benchRandom(i+1);
+	int t = game.shotOrder[i]; game.shotOrder[i] = game.shotOrder[j]; game.shotOrder[j] = t;
+    }
+}
+
+/*
+ * The same for boards of any size: boardSize-2 ships, no cap.
+ */
+struct LargeSetup {
+    int numShips;
+    vector<int> row, col, length;
+    vector<Direction> dir;
+    vector<int> shotOrder;
+};
+
+static void makeLargeGame( int boardSize, LargeSetup& game ) {
+    game.numShips = boardSize-2;
+    game.row.resize(game.numShips);
+    game.col.resize(game.numShips);
+    game.length.resize(game.numShips);
+    game.dir.resize(game.numShips);
+    for(int i=0; i<game.numShips; i++) {
+	game.length[i] = benchRandom(3) + 3;
+	game.dir[i] = benchRandom(2) ? Horizontal : Vertical;
+	game.row[i] = benchRandom(boardSize);
+	game.col[i] = benchRandom(boardSize);
+    }
+    int cells = boardSize*boardSize;
+    game.shotOrder.resize(cells);
+    for(int i=0; i<cells; i++) game.shotOrder[i] = i;
+    for(int i=cells-1; i>0; i--) {
+	int j = benchRandom(i+1);
+	int t = game.shotOrder[i]; game.shotOrder[i] = game.shotOrder[j]; game.shotOrder[j] = t;
+    }
+}
+
+template <class BoardType, class Setup>
+static int playGame( BoardType& board, int boardSize, const Setup& game ) {
+    for(int i=0; i<game.numShips; i++) {
+	board.placeShip(game.row[i], game.col[i], game.length[i], game.dir[i]);
+    }
+    int shots = 0;
+    int cells = boardSize*boardSize;
+    for(int i=0; i<cells; i++) {
+	int cell = game.shotOrder[i];
+	shots++;
+	if( board.processShot(cell/boardSize, cell%boardSize) == KILL && board.hasWon() ) break;
+    }
+    return shots;
+}
+
+/*
+ * Plays the game on both boards, checking after every shot that they give
+ * the same answers and show the same cells.
+ */
+template <class BoardType, class ReferenceType, class Setup>
+static bool sameAnswers( BoardType& board, ReferenceType& reference, int boardSize, const Setup& game ) {
+    for(int i=0; i<game.numShips; i++) {
+	bool ok = board.placeShip(game.row[i], game.col[i], game.length[i], game.dir[i]);
+	if( ok != reference.placeShip(game.row[i], game.col[i], game.length[i], game.dir[i]) ) return false;
+    }
+    int cells = boardSize*boardSize;
+    for(int i=0; i<cells; i++) {
+	int r = game.shotOrder[i]/boardSize, c = game.shotOrder[i]%boardSize;
+	if( board.processShot(r, c) != reference.processShot(r, c) ) return false;
+	// Duplicate shots must agree too.
+	if( board.processShot(r, c) != reference.processShot(r, c) ) return false;
+	if( board.hasWon() != reference.hasWon() ) return false;
+	for(int row=0; row<boardSize; row++) {
+	    for(int col=0; col<boardSize; col++) {
+		if( board.getOwnerView(row, col) != reference.getOwnerView(row, col) ||
+		    board.getOpponentView(row, col) != reference.getOpponentView(row, col) ||
+		    board.getShipMark(row, col) != reference.getShipMark(row, col) ) return false;
+	    }
+	}
+    }
+    return board.processShot(-1, 0) == reference.processShot(-1, 0);
+}
+
+static bool checkBoards( int boardSize, const GameSetup& game ) {
+    BoardV3 board(boardSize);
+    ReferenceBoardV3 reference(boardSize);
+    return sameAnswers(board, reference, boardSize, game);
+}
+
+static void benchBoard() {
+    const int Games = 20000;
+    static GameSetup games[Games];
+
+    // Ship placement errors are expected (random placements collide); keep them quiet.
+    streambuf* savedErr = cerr.rdbuf(0);
+
+    for(int boardSize=3; boardSize<=BoardV3::MaxBoardSize; boardSize++) {
+	for(int i=0; i<Games; i++) makeGame(boardSize, games[i]);
+
+	int mismatches = 0;
+	for(int i=0; i<Games/10; i++) {
+	    if( !checkBoards(boardSize, games[i]) ) mismatches++;
+	}
+
+	long shots = 0;
+	Clock::time_point start = Clock::now();
+	for(int i=0; i<Games; i++) {
+	    ReferenceBoardV3 board(boardSize);
+	    shots += playGame(board, boardSize, games[i]);
+	}
+	double referenceNs = nanosSince(start, shots);
+
+	shots = 0;
+	start = Clock::now();
+	for(int i=0; i<Games; i++) {
+	    BoardV3 board(boardSize);
+	    shots += playGame(board, boardSize, games[i]);
+	}
+	double bitboardNs = nanosSince(start, shots);
+
+	cout << "board " << setw(2) << boardSize << "x" << setw(2) << left << boardSize << right
+	     << "  reference " << setw(7) << fixed << setprecision(1) << referenceNs << " ns/shot"
+	     << "  bitboard " << setw(7) << bitboardNs << " ns/shot"
+	     << "  mismatches " << mismatches << endl;
+	failedChecks += mismatches;
+    }
+
+    cerr.rdbuf(savedErr);
+}
+
+/*
+ * Times whole games per shot: on the stack, or made by factory and played
+ * through GameBoard* like AIContest does.
+ */
+template <class BoardType>
+static double timeBoard( BoardType* (*make)(int), int boardSize, const GameSetup games[], int numGames ) {
+    long shots = 0;
+    Clock::time_point start = Clock::now();
+    for(int i=0; i<numGames; i++) {
+	BoardType* board = make(boardSize);
+	shots += playGame(*board, boardSize, games[i]);
+	delete board;
+    }
+    return nanosSince(start, shots);
+}
+
+static BoardV3* newBoardV3( int boardSize ) { return new BoardV3(boardSize); }
+
+template <int N>
+static Board<N>* newBoard( int ) { return new Board<N>(); }
+
+template <int N>
+static void benchSizedBoard( GameSetup games[], int numGames ) {
+    for(int i=0; i<numGames; i++) makeGame(N, games[i]);
+
+    int mismatches = 0;
+    for(int i=0; i<numGames/10; i++) {
+	BoardV3 generic(N);
+	Board<N> sized;
+	if( !sameAnswers(sized, generic, N, games[i]) ) mismatches++;
+	for(int cell=0; cell<N*N; cell++) {
+	    if( sized.getShipCells(cell/N, cell%N) != generic.getShipCells(cell/N, cell%N) ) mismatches++;
+	}
+    }
+
+    double genericNs = timeBoard(newBoardV3, N, games, numGames);
+    double sizedNs = timeBoard(newBoard<N>, N, games, numGames);
+    double genericVirtualNs = timeBoard(&BoardV3::create, N, games, numGames);
+    double sizedVirtualNs = timeBoard(boardFactory(N), N, games, numGames);
+
+    cout << "sized " << setw(2) << N << "x" << setw(2) << left << N << right
+	 << "  BoardV3 " << setw(6) << fixed << setprecision(1) << genericNs << " ns/shot"
+	 << "  Board<" << N << "> " << setw(6) << sizedNs << " ns/shot"
+	 << "  via GameBoard* " << setw(6) << genericVirtualNs << " / " << setw(6) << sizedVirtualNs << " ns/shot"
+	 << "  mismatches " << mismatches << endl;
+    failedChecks += mismatches;
+}
+
+static void benchSized() {
+    const int Games = 20000;
+    static GameSetup games[Games];
+
+    streambuf* savedErr = cerr.rdbuf(0);	// Expected placement errors
+    benchSizedBoard<3>(games, Games);
+    benchSizedBoard<4>(games, Games);
+    benchSizedBoard<5>(games, Games);
+    benchSizedBoard<6>(games, Games);
+    benchSizedBoard<7>(games, Games);
+    benchSizedBoard<8>(games, Games);
+    benchSizedBoard<9>(games, Games);
+    benchSizedBoard<10>(games, Games);
+    cerr.rdbuf(savedErr);
+}
+
+static bool sameShip( const ShipLocation& a, const ShipLocation& b ) {
+    if( a.length == 0 || b.length == 0 ) return a.length == b.length;
+    return a.row == b.row && a.col == b.col && a.length == b.length && a.dir == b.dir;
+}
+
+static void benchLarge() {
+    streambuf* savedErr = cerr.rdbuf(0);	// Expected placement errors
+
+    const int Checks = 2000;
+    static GameSetup games[Checks];
+    for(int boardSize=3; boardSize<=MAX_BOARD_SIZE; boardSize++) {
+	int mismatches = 0;
+	for(int i=0; i<Checks; i++) {
+	    makeGame(boardSize, games[i]);
+	    BoardV3 generic(boardSize);
+	    LargeBoard large(boardSize);
+	    if( !sameAnswers(large, generic, boardSize, games[i]) ) mismatches++;
+	    for(int cell=0; cell<boardSize*boardSize; cell++) {
+		int row = cell/boardSize, col = cell%boardSize;
+		if( large.getShipCells(row, col) != generic.getShipCells(row, col) ||
+		    !sameShip(large.getShip(row, col), generic.getShip(row, col)) ) mismatches++;
+	    }
+	}
+	double genericNs = timeBoard(newBoardV3, boardSize, games, Checks);
+	double largeNs = timeBoard(&LargeBoard::create, boardSize, games, Checks);
+	cout << "large " << setw(3) << boardSize << "x" << setw(3) << left << boardSize << right
+	     << "  BoardV3 " << setw(6) << fixed << setprecision(1) << genericNs << " ns/shot"
+	     << "  LargeBoard " << setw(6) << largeNs << " ns/shot"
+	     << "  mismatches " << mismatches << endl;
+	failedChecks += mismatches;
+    }
+
+    // Whole games, made and played through GameBoard* as AIContest does.
+    const int Sizes[] = { 16, 32, 64, 100, MAX_LARGE_BOARD_SIZE };
+    const int Games = 200;
+    static LargeSetup large[Games];
+    for(int s=0; s<int(sizeof Sizes / sizeof Sizes[0]); s++) {
+	int size = Sizes[s];
+	for(int i=0; i<Games; i++) makeLargeGame(size, large[i]);
+	long shots = 0;
+	Clock::time_point start = Clock::now();
+	for(int i=0; i<Games; i++) {
+	    GameBoard* board = LargeBoard::create(size);
+	    shots += playGame(*board, size, large[i]);
+	    delete board;
+	}
+	double perShot = nanosSince(start, shots);
+	double perCell = perShot * shots / (double(Games) * size * size);
+	cout << "large " << setw(3) << size << "x" << setw(3) << left << size << right
+	     << "  LargeBoard " << setw(6) << fixed << setprecision(1) << perShot << " ns/shot "
+	     << setw(6) << perCell << " ns/cell" << endl;
+    }
+
+    cerr.rdbuf(savedErr);
+}
+
+/*
+ * The player side of one shot, called through pointers like the virtual
+ * calls in AIContest so nothing gets inlined away.
+ */
+static long messageSink = 0;
+
+static Message legacyMove( int row, int col ) {
+    return Message( SHOT, row, col, "Target Shooting", None, 1 );
+}
+static void legacyUpdate( Message msg ) {
+    messageSink += msg.getRow() + msg.getCol() + msg.getMessageType();
+}
+static PackedMessage packedMove( int row, int col ) {
+    static const int label = MessageLabels::intern("Target Shooting");
+    return PackedMessage( SHOT, row, col, None, 1, label );
+}
+static void packedUpdate( PackedMessage msg ) {
+    messageSink += msg.getRow() + msg.getCol() + msg.getMessageType();
+}
+
+static void benchMessage() {
+    const long Shots = 20000000;
+    Message (*volatile getLegacy)(int, int) = legacyMove;
+    void (*volatile updateLegacy)(Message) = legacyUpdate;
+    PackedMessage (*volatile getPacked)(int, int) = packedMove;
+    void (*volatile updatePacked)(PackedMessage) = packedUpdate;
+
+    Clock::time_point start = Clock::now();
+    for(long i=0; i<Shots; i++) {
+	Message move = getLegacy(i & 7, (i >> 3) & 7);
+	Message result( HIT, move.getRow(), move.getCol(), "" );
+	updateLegacy(result);
+    }
+    double legacyNs = nanosSince(start, Shots);
+
+    start = Clock::now();
+    for(long i=0; i<Shots; i++) {
+	PackedMessage move = getPacked(i & 7, (i >> 3) & 7);
+	PackedMessage result( HIT, move.getRow(), move.getCol() );
+	updatePacked(result);
+    }
+    double packedNs = nanosSince(start, Shots);
+
+    cout << "message  Message " << setw(7) << fixed << setprecision(1) << legacyNs << " ns/shot"
+	 << "  PackedMessage " << setw(7) << packedNs << " ns/shot"
+	 << "  (" << sizeof(Message) << " vs " << sizeof(PackedMessage) << " bytes)" << endl;
+}
+
+static void benchRandomNumbers() {
+    const long Draws = 100000000;
+    long sum = 0;
+
+    Clock::time_point start = Clock::now();
+    for(long i=0; i<Draws; i++) {
+	sum += rand() % 100;
+    }
+    double randNs = nanosSince(start, Draws);
+
+    Random random(42);
+    start = Clock::now();
+    for(long i=0; i<Draws; i++) {
+	sum += random.below(100);
+    }
+    double xoshiroNs = nanosSince(start, Draws);
+
+    cout << "random   rand() " << setw(6) << fixed << setprecision(2) << randNs << " ns"
+	 << "  Random::below() " << setw(6) << xoshiroNs << " ns" << "  (sum " << sum << ")" << endl;
+}
+
+/*
+ * Plays games of shooter against ships placed at random, timing only the
+ * getMove() calls.
+ */
+static void timeShooter( PackedPlayerV2& shooter, int boardSize, int games,
+                         double& nanosPerMove, double& shotsPerGame )
+{
+    DensityPlayer placer(boardSize);
+    placer.setRandom(Random(1));
+    shooter.setRandom(Random(2));
+    int cells = boardSize*boardSize;
+    int numShips = boardSize-2 > 6 ? 6 : boardSize-2;
+
+    chrono::duration<double, nano> moveTime(0);
+    long moves = 0;
+    for(int g=0; g<games; g++) {
+	BoardV3 board(boardSize);
+	placer.newRound();
+	shooter.newRound();
+	for(int i=0; i<numShips; i++) {
+	    int length;
+	    do length = benchRandom(3) + 3; while( length > boardSize );	// Only on boards under 5x5
+	    PackedMessage loc = placer.placePackedShip(length);
+	    board.placeShip(loc.getRow(), loc.getCol(), length, loc.getDirection());
+	    shooter.placePackedShip(length);
+	}
+	for(int shot=0; shot<2*cells && !board.hasWon(); shot++) {
+	    Clock::time_point start = Clock::now();
+	    PackedMessage move = shooter.getPackedMove();
+	    moveTime += Clock::now() - start;
+	    moves++;
+
+	    int row = move.getRow(), col = move.getCol();
+	    char result = board.processShot(row, col);
+	    if( result == KILL ) {
+		ShipKill kill = { row, col, boardSize, board.getShipCells(row, col), board.getShip(row, col) };
+		shooter.updateKill(kill);
+	    } else {
+		shooter.updatePacked(PackedMessage(result, row, col));
+	    }
+	}
+    }
+    nanosPerMove = moveTime.count() / moves;
+    shotsPerGame = double(moves) / games;
+}
+
+static void benchDensity() {
+    const int Games = 2000;
+    for(int boardSize=6; boardSize<=10; boardSize+=2) {
+	Deng deng(boardSize);
+	DensityPlayer density(boardSize);
+	double dengNs, dengShots, densityNs, densityShots;
+	timeShooter(deng, boardSize, Games, dengNs, dengShots);
+	timeShooter(density, boardSize, Games, densityNs, densityShots);
+
+	cout << "density " << setw(2) << boardSize << "x" << setw(2) << left << boardSize << right
+	     << "  Deng " << setw(7) << fixed << setprecision(1) << dengNs << " ns/move " << setw(5) << dengShots << " shots"
+	     << "  DensityPlayer " << setw(7) << densityNs << " ns/move " << setw(5) << densityShots << " shots" << endl;
+    }
+}
+
+static void benchTablebase() {
+    const int Games = 2000;
+    if( !TablebasePlayer::table().isOpen() ) return;	// Says why
+    streambuf* savedErr = cerr.rdbuf(0);	// A fleet the placer can't fit complains
+    for(int boardSize=Tablebase::MinBoardSize; boardSize<=Tablebase::MaxBoardSize; boardSize++) {
+	Deng deng(boardSize);
+	DensityPlayer density(boardSize);
+	TablebasePlayer perfect(boardSize);
+	double dengNs, dengShots, densityNs, densityShots, perfectNs, perfectShots;
+	timeShooter(deng, boardSize, Games, dengNs, dengShots);
+	timeShooter(density, boardSize, Games, densityNs, densityShots);
+	timeShooter(perfect, boardSize, Games, perfectNs, perfectShots);
+
+	cout << "tablebase " << boardSize << "x" << boardSize << fixed << setprecision(1)
+	     << "  Deng " << setw(6) << dengNs << " ns/move " << setw(5) << setprecision(2) << dengShots << " shots"
+	     << "  DensityPlayer " << setw(6) << setprecision(1) << densityNs << " ns/move " << setw(5)
+	     << setprecision(2) << densityShots << " shots"
+	     << "  TablebasePlayer " << setw(6) << setprecision(1) << perfectNs << " ns/move " << setw(5)
+	     << setprecision(2) << perfectShots << " shots" << endl;
+    }
+    cerr.rdbuf(savedErr);
+}
+
+// A task with nothing to do, to time a WorkerPool's fork/join alone.
+class EmptyTask: public ParallelTask {
+    public:
+	void runPart( int, int ) override {}
+};
+
+static void benchMonteCarlo() {
+    const int Games = 100, BoardSize = 10, PoolRuns = 20000;
+    const int budgets[] = { 50, MonteCarloPlayer::DefaultBudgetMicros, 1000 };
+    const int threadCounts[] = { 2, 4 };
+
+    DensityPlayer density(BoardSize);
+    double densityNs, densityShots;
+    timeShooter(density, BoardSize, Games, densityNs, densityShots);
+    cout << "montecarlo " << BoardSize << "x" << BoardSize << "  DensityPlayer                " << setw(9) << fixed
+	 << setprecision(1) << densityNs << " ns/move " << setw(5) << setprecision(2) << densityShots << " shots" << endl;
+
+    for(size_t i=0; i<sizeof budgets / sizeof budgets[0] + sizeof threadCounts / sizeof threadCounts[0]; i++) {
+	bool threaded = i >= sizeof budgets / sizeof budgets[0];
+	int budget = threaded ? budgets[0] : budgets[i];
+	int threads = threaded ? threadCounts[i - sizeof budgets / sizeof budgets[0]] : 1;
+	MonteCarloPlayer sampler(BoardSize, budget, threads);
+	double samplerNs, samplerShots;
+	timeShooter(sampler, BoardSize, Games, samplerNs, samplerShots);
+	cout << "montecarlo " << BoardSize << "x" << BoardSize << "  MonteCarlo " << setw(4) << budget << "us "
+	     << setw(2) << threads << " threads " << setw(9) << setprecision(1) << samplerNs << " ns/move "
+	     << setw(5) << setprecision(2) << samplerShots << " shots  " << setw(9) << setprecision(0)
+	     << sampler.samplesPerSecond() << " layouts/s  "
+	     << setw(6) << double(sampler.samplesDrawn()) / sampler.movesSampled() << " per move" << endl;
+    }
+
+    EmptyTask empty;
+    for(size_t t=0; t<sizeof threadCounts / sizeof threadCounts[0]; t++) {
+	WorkerPool pool(threadCounts[t]);
+	pool.run(empty);	// Threads started
+	Clock::time_point start = Clock::now();
+	for(int i=0; i<PoolRuns; i++) pool.run(empty);
+	cout << "montecarlo pool " << threadCounts[t] << " threads  fork/join " << setw(8) << setprecision(1)
+	     << nanosSince(start, PoolRuns) << " ns" << endl;
+    }
+}
+
+static void benchModels() {
+    const int Reads = 100000, Commits = 2000, Players = 2000, BoardSize = 10;
+    const char* fileName = "benchModels.bin";
+    const string opponent = "Lewis";
+
+    OpponentModels& store = OpponentModels::shared();
+    unlink(fileName);
+    if( !store.open(fileName) ) {
+	cout << "models  can't open " << fileName << ": " << store.error() << endl;
+	return;
+    }
+    OpponentModel delta, model;
+    delta.clear();
+    delta.rounds = 1;
+    for(int cell=0; cell<BoardSize*BoardSize; cell++) delta.heat[cell] = cell % 3;
+
+    long before = allocations;
+    Clock::time_point start = Clock::now();
+    for(int i=0; i<Commits; i++) store.add(opponent, BoardSize, delta);
+    double commitNs = nanosSince(start, Commits);
+    double commitAllocations = double(allocations - before) / Commits;
+
+    int sink = 0;
+    start = Clock::now();
+    for(int i=0; i<Reads; i++) {
+	store.read(opponent, BoardSize, model);
+	sink += model.rounds;
+    }
+    double readNs = nanosSince(start, Reads);
+
+    double playerNs[2];
+    for(int warm=0; warm<2; warm++) {
+	OpponentModels::setOpponent(warm ? &opponent : 0);
+	start = Clock::now();
+	for(int i=0; i<Players; i++) {
+	    Deng* deng = new Deng(BoardSize);
+	    sink += deng->getPackedMove().getRow();
+	    delete deng;	// Nothing to commit before a round
+	}
+	playerNs[warm] = nanosSince(start, Players);
+    }
+    OpponentModels::setOpponent(0);
+    bool ok = store.read(opponent, BoardSize, model) && model.rounds == Commits;
+    store.close();
+    unlink(fileName);
+
+    cout << fixed << setprecision(1)
+	 << "models  read   " << setw(9) << readNs << " ns" << endl
+	 << "models  commit " << setw(9) << commitNs << " ns  " << setprecision(2) << commitAllocations
+	 << " allocations" << (ok && sink != -1 ? "" : "  (rounds lost)") << endl << setprecision(1)
+	 << "models  new Deng  cold " << setw(9) << playerNs[0] << " ns  warm " << setw(9) << playerNs[1] << " ns" << endl;
+}
+
+/*
+ * Players for the batch benchmark: DumbPlayerV2 and the two scanners, which
+ * count their hits and kills in scanTally.
+ */
+static ScanTally scanTally[NumScanOrders];
+static PlayerV2* getScanner( int playerId, int boardSize ) {
+    if( playerId == 0 ) return new DumbPlayerV2(boardSize);
+    ScanOrder order = ScanOrder(playerId-1);
+    return new ScanPlayer(boardSize, order, &scanTally[order]);
+}
+
+static bool sameStats( const MatchStats& a, const MatchStats& b ) {
+    if( a.ties != b.ties ) return false;
+    for(int side=0; side<2; side++) {
+	if( a.wins[side] != b.wins[side] || a.shotsTaken[side] != b.shotsTaken[side] ||
+	    a.gamesCounted[side] != b.gamesCounted[side] ) return false;
+    }
+    return true;
+}
+
+static void benchBatch() {
+    const string names[3] = { "Dumb Player", "Row Scan", "Parity Scan" };
+    const unsigned int Seed = 2026;
+    const int ScalarGames = 2000, BatchGames = 200000;
+
+    streambuf* savedErr = cerr.rdbuf(0);	// Forfeits on small boards complain
+    for(int boardSize=3; boardSize<=MAX_BOARD_SIZE; boardSize++) {
+	MatchRunner runner(getScanner, names, boardSize, Seed);
+	BatchSim batch(boardSize, RowScan, ParityScan);
+	BatchSim reversed(boardSize, ParityScan, RowScan);
+	int mismatches = 0;
+
+	// DumbPlayerV2 against the parity scanner, then the two scanners the
+	// other way round (so player 2 wins) for hits and kills.
+	MatchJob dumb = { 0, 0, 2, 0, ScalarGames };
+	Clock::time_point start = Clock::now();
+	MatchStats scalar = runner.play(dumb, -1, false, 0, 0);
+	double scalarNs = nanosSince(start, ScalarGames);
+
+	MatchJob scanners = { 1, 2, 1, 0, ScalarGames };
+	scanTally[RowScan] = scanTally[ParityScan] = ScanTally();
+	MatchStats scalarScanners = runner.play(scanners, -1, false, 0, 0);
+
+	double batchNs[BatchSim::NumKernels];
+	for(int k=0; k<BatchSim::NumKernels; k++) {
+	    batchNs[k] = 0;
+	    if( batch.setKernel(BatchSim::Kernel(k)) != k ) continue;
+	    reversed.setKernel(BatchSim::Kernel(k));
+	    ScanTally tally[2];
+	    if( !sameStats(batch.play(dumb, Seed), scalar) ) mismatches++;
+	    if( !sameStats(reversed.play(scanners, Seed, tally), scalarScanners) ) mismatches++;
+	    for(int side=0; side<2; side++) {
+		const ScanTally& expected = scanTally[side == 0 ? ParityScan : RowScan];
+		if( tally[side].hits != expected.hits || tally[side].kills != expected.kills ) mismatches++;
+	    }
+
+	    MatchJob many = { 0, 0, 2, 0, BatchGames };
+	    start = Clock::now();
+	    batch.play(many, Seed);
+	    batchNs[k] = nanosSince(start, BatchGames);
+	}
+
+	cout << "batch " << setw(2) << boardSize << "x" << setw(2) << left << boardSize << right
+	     << "  MatchRunner " << setw(7) << fixed << setprecision(1) << scalarNs << " ns/game";
+	for(int k=0; k<BatchSim::NumKernels; k++) {
+	    cout << "  " << BatchSim::kernelName(BatchSim::Kernel(k)) << " " << setw(6) << batchNs[k] << " ns/game";
+	}
+	cout << "  mismatches " << mismatches << endl;
+	failedChecks += mismatches;
+    }
+    cerr.rdbuf(savedErr);
+}
+
+static PlayerV2* getAllocPlayer( int playerId, int boardSize ) {
+    switch( playerId ) {
+	default:
+	case 0: return new DumbPlayerV2(boardSize);
+	case 1: return new Deng(boardSize);
+	case 2: return new DensityPlayer(boardSize);
+	case 3: return new MonteCarloPlayer(boardSize, 20, 2, 80);	// Pool threads included; counted draws, for repeatable runs
+    }
+}
+
+/*
+ * Plays a one-round job and a longer one between the same players; the
+ * difference is what the extra rounds allocated. A job first warms up
+ * whatever is made once per process (the diagnostics writer, say), which
+ * would otherwise count against the one-round job and hide the difference,
+ * and each job's diagnostics are flushed before the count is read, so the
+ * writer thread's allocations land in the job that caused them.
+ */
+static void benchAlloc() {
+    const string names[4] = { "Dumb Player", "Deng", "Density Player", "Monte Carlo" };
+    const int Rounds = 1000;
+    struct { int player1Id, player2Id, boardSize; } matches[] = {
+	{ 1, 2, 6 }, { 1, 2, 10 }, { 0, 1, 10 }, { 0, 1, 32 }, { 3, 2, 10 },
+    };
+    for(size_t m=0; m<sizeof matches / sizeof matches[0]; m++) {
+	int boardSize = matches[m].boardSize;
+	MatchRunner runner(getAllocPlayer, names, boardSize, 2026, boardFactory(boardSize));
+	MatchJob once = { 0, matches[m].player1Id, matches[m].player2Id, 0, 1 };
+	MatchJob many = once;
+	many.numRounds = 1+Rounds;
+
+	runner.play(once, -1, false, 0, 0);
+	Diagnostics::flush();
+	long before = allocations;
+	runner.play(once, -1, false, 0, 0);
+	Diagnostics::flush();
+	long first = allocations - before;
+	before = allocations;
+	runner.play(many, -1, false, 0, 0);
+	Diagnostics::flush();
+	long later = allocations - before - first;
+	double perRound = double(later) / Rounds;
+
+	cout << "alloc " << setw(3) << boardSize << "x" << setw(3) << left << boardSize << right << "  "
+	     << setw(14) << left << names[matches[m].player1Id] << " vs " << setw(14) << names[matches[m].player2Id]
+	     << right << "  job " << setw(5) << first << " allocations, then "
+	     << setw(6) << fixed << setprecision(2) << perRound << " per round" << (later > 0 ? "  FAILED" : "") << endl;
+	if( later > 0 ) failedChecks++;
+    }
+}
+
+static void benchRatings() {
+    const int Matches = 20;
+    const int roundCounts[2] = { 100, 1000 };
+    for(int r=0; r<2; r++) {
+	int rounds = roundCounts[r];
+	RatingTable table(10);
+	int winner = table.find("Winner"), loser = table.find("Loser");
+	table.addMatch(winner, loser, rounds, 0, 0);
+	double firstDeviation = table[winner].deviation;
+	Clock::time_point start = Clock::now();
+	for(int m=1; m<Matches; m++) {
+	    table.addMatch(winner, loser, rounds, 0, 0);
+	}
+	double matchNs = nanosSince(start, Matches-1);
+	bool ok = table[winner].rating > table[loser].rating && table[winner].deviation < firstDeviation &&
+		  table[loser].deviation < firstDeviation;
+	cout << "ratings " << setw(4) << rounds << "-0 x" << Matches << "  " << setw(8) << fixed << setprecision(0)
+	     << matchNs << " ns/match  winner " << table[winner].rating << " +/- " << table[winner].deviation
+	     << "  loser " << table[loser].rating << " +/- " << table[loser].deviation
+	     << "  (deviation " << firstDeviation << " after the first)" << (ok ? "" : "  FAILED") << endl;
+	if( !ok ) failedChecks++;
+    }
+}
+
+static PlayerV2* getScanPlayer( int, int boardSize ) {
+    return new ScanPlayer(boardSize, RowScan);
+}
+
+static void benchRemote() {
+    const int Calls = 200000;
+    const int BoardSize = 10;
+    PackedMessage miss( MISS, 0, 0 );
+
+    ScanPlayer scanner( BoardSize, RowScan );
+    PackedPlayerV2* direct = &scanner;	// Called through the vtable, as AIContest does
+    direct->newRound();
+    int sink = 0;
+    Clock::time_point start = Clock::now();
+    for(int i=0; i<Calls; i++) {
+	sink += direct->getPackedMove().getRow();
+    }
+    double directMoveNs = nanosSince(start, Calls);
+    start = Clock::now();
+    for(int i=0; i<Calls; i++) {
+	direct->updatePacked(miss);
+    }
+    double directUpdateNs = nanosSince(start, Calls);
+
+    SandboxLimits limits;
+    SandboxPlayer remote( getScanPlayer, 0, BoardSize, "Scan", limits );
+    LatencyHistogram roundTrips;
+    remote.newRound();
+    start = Clock::now();
+    for(int i=0; i<Calls; i++) {
+	uint64_t before = monotonicNanos();
+	sink += remote.getPackedMove().getRow();
+	roundTrips.record(monotonicNanos() - before);
+    }
+    double remoteMoveNs = nanosSince(start, Calls);
+    start = Clock::now();
+    for(int i=0; i<Calls; i++) {
+	remote.updatePacked(miss);
+    }
+    remote.getPackedMove();	// Waits for the child to catch up
+    double remoteUpdateNs = nanosSince(start, Calls);
+
+    cout << fixed << setprecision(1)
+	 << "remote getMove  direct " << setw(7) << directMoveNs << " ns  sandbox " << setw(8) << remoteMoveNs
+	 << " ns  (p50 " << roundTrips.percentile(0.5) << " ns, p99 " << roundTrips.percentile(0.99) << " ns)" << endl
+	 << "remote update   direct " << setw(7) << directUpdateNs << " ns  sandbox " << setw(8) << remoteUpdateNs
+	 << " ns" << (remote.forfeited() || sink == -1 ? "  (sandbox failed)" : "") << endl;
+}
+
+int main( int argc, char* argv[] ) {
+    struct { const char* name; void (*run)(); } benchmarks[] = {
+	{ "board", benchBoard },
+	{ "sized", benchSized },
+	{ "large", benchLarge },
+	{ "message", benchMessage },
+	{ "random", benchRandomNumbers },
+	{ "density", benchDensity },
+	{ "tablebase", benchTablebase },
+	{ "montecarlo", benchMonteCarlo },
+	{ "models", benchModels },
+	{ "batch", benchBatch },
+	{ "alloc", benchAlloc },
+	{ "ratings", benchRatings },
+	{ "remote", benchRemote },
+    };
+    const int NumBenchmarks = sizeof benchmarks / sizeof benchmarks[0];
+
+    for(int i=0; i<NumBenchmarks; i++) {
+	bool selected = argc < 2;
+	for(int a=1; a<argc; a++) {
+	    if( strcmp(argv[a], benchmarks[i].name) == 0 ) selected = true;
+	}
+	if( selected ) benchmarks[i].run();
+    }
+    if( failedChecks > 0 ) {
+	cerr << "bench: " << failedChecks << " failed checks" << endl;
+	return 1;
+    }
+    return 0;
+}
@@ -8,9 +8,11 @@
  */
 
 #include <iostream>
+#include <fstream>
 #include <iomanip>
 #include <cctype>
 #include <unistd.h>
+#include <vector>
 
 // Next 2 to access and setup the random number generator.
 #include <cstdlib>
@@ -18,8 +20,16 @@
 
 // BattleShips project specific includes.
 #include "BoardV3.h"
+#include "GameBoard.h"
 #include "AIContest.h"
 #include "PlayerV2.h"
+#include "MatchRunner.h"
+#include "Options.h"
+#include "GameLog.h"
+#include "SequentialTest.h"
+#include "Ratings.h"
+#include "Plugins.h"
+#include "OpponentModels.h"
 #include "conio.h"
 
 // Include your player here
@@ -28,9 +38,20 @@
 #include "CleanPlayerV2.h"
 #include "GamblerPlayerV2.h"
 
+// Engine based players
+#include "DensityPlayer.h"
+#include "TablebasePlayer.h"
+#include "MonteCarloPlayer.h"
+
 
 PlayerV2* getPlayer( int playerId, int boardSize );
-void playMatch( int player1Id, int player2Id, bool showMoves );
+bool loadPlugins( bool text );
+MatchStats playMatch( MatchRunner& runner, int pairing, int player1Id, int player2Id );
+struct Pairing;
+long playSequential( MatchRunner& runner, const vector<Pairing>& pairings, vector<MatchStats>& results );
+int playRated( MatchRunner& runner, unsigned int seed );
+void reportMatch( int player1Id, int player2Id, const MatchStats& stats );
+void reportTiming( int player1Id, int player2Id, const MatchStats& stats );
 int comparePlayers (const void * a, const void * b);
 
 using namespace std;
@@ -38,90 +59,246 @@ using namespace conio;
 
 float secondsPerMove = 1;
 int boardSize;	// BoardSize
+BoardFactory makeBoard;	// Board<boardSize> once the size is known
 int totalGames = 0;
-int totalCountedMoves = 0;
-const int NumPlayers = 3;
-
-int wins[NumPlayers][NumPlayers];
-int playerIds[NumPlayers];
-int lives[NumPlayers];
-int winCount[NumPlayers];
-int statsShotsTaken[NumPlayers];
-int statsGamesCounted[NumPlayers];
-string playerNames[NumPlayers] = { 
+RunOptions options;
+GameLogWriter gameLog;	// Used if options.logFile is set
+ofstream timingCsv;	// Used if options.timingCsv is set
+SandboxLimits sandboxLimits;	// Used if options.sandbox is set
+const int NumBuiltInPlayers = 6;
+const int MaxPlayers = 64;	// Built-in players and plugins
+int numPlayers = NumBuiltInPlayers;
+PluginRegistry plugins;	// Players from --plugins, numbered after the built-in ones
+
+int wins[MaxPlayers][MaxPlayers];
+int numEntrants;	// Players in this tournament: playerIds[0..numEntrants-1]
+int playerIds[MaxPlayers];
+int lives[MaxPlayers];
+int winCount[MaxPlayers];
+long statsShotsTaken[MaxPlayers];
+int statsGamesCounted[MaxPlayers];
+string playerNames[MaxPlayers] = { 
     "Dumb Player",
     "Gambler Player",
     "Clean Player",
+    "Density Player",
+    "Tablebase Player",
+    "Monte Carlo Player",
 };
+// Largest board each player can play on; the classic players keep fixed 10x10 arrays.
+int maxBoardSize[MaxPlayers] = { MAX_LARGE_BOARD_SIZE, MAX_BOARD_SIZE, MAX_BOARD_SIZE, MAX_BOARD_SIZE, MAX_BOARD_SIZE,
+				 MAX_BOARD_SIZE };
+
 
+// A match of the tournament, in the order the matches are reported.
+struct Pairing {
+    int player1Id;
+    int player2Id;
+    bool skipEliminated;	// Not played if either player has no lives left
+};
 
-int main() {
+int main( int argc, char* argv[] ) {
     //bool silent = false;
 
+    if( !parseOptions(argc, argv, options) ) {
+	return 1;
+    }
+    // Seed the random streams from the clock unless told otherwise.
+    unsigned int seed = options.haveSeed ? options.seed : time(NULL);
+    if( !options.logFile.empty() && !gameLog.open(options.logFile) ) {
+	cerr << "Can't create game log " << options.logFile << endl;
+	return 1;
+    }
+    if( !options.timingCsv.empty() ) {
+	timingCsv.open(options.timingCsv.c_str());
+	if( !timingCsv ) {
+	    cerr << "Can't create " << options.timingCsv << endl;
+	    return 1;
+	}
+	writeTimingCsvHeader(timingCsv);
+    }
+    if( !options.modelFile.empty() && !OpponentModels::shared().open(options.modelFile) ) {
+	cerr << "Can't use opponent models: " << OpponentModels::shared().error() << endl;
+	return 1;
+    }
+    sandboxLimits.moveMillis = options.deadlineMillis;
+    sandboxLimits.memoryBytes = long(options.memoryMegabytes) << 20;
+    bool text = options.format == TextOutput;
+    if( !loadPlugins(text) ) {
+	return 1;
+    }
+
+    // Everybody plays unless a player list was given.
+    numEntrants = 0;
+    if( options.players.empty() ) {
+	for(int i=0; i<numPlayers; i++) playerIds[numEntrants++] = i;
+    }
+    for(size_t i=0; i<options.players.size(); i++) {
+	int id = findPlayer(options.players[i], playerNames, numPlayers);
+	if( id < 0 ) {
+	    cerr << "No player called '" << options.players[i] << "'" << endl;
+	    return 1;
+	}
+	playerIds[numEntrants++] = id;
+    }
+
+    // Now to get the board size.
+    if( text ) cout << "Welcome to the AI Bot contest. (seed " << seed << ")" << endl << endl;
+    boardSize = options.boardSize;
+    if( boardSize == 0 ) {
+	cout << "What size board would you like? [Anything other than numbers 3-"
+	     << MAX_LARGE_BOARD_SIZE << " exits.] ";
+	cin >> boardSize;
+    }
+    // If have invalid board size input (non-number, or 0-2, or too big).
+    if ( !cin || boardSize < 3 || boardSize > MAX_LARGE_BOARD_SIZE ) {
+	cout << "Exiting" << endl;
+	return 1;
+    }
+    makeBoard = boardFactory(boardSize);	// The one Board<N> every game uses
+
+    // Players named on the command line must fit the board; the rest sit it out.
+    int entrants = numEntrants;
+    numEntrants = 0;
+    for(int i=0; i<entrants; i++) {
+	int id = playerIds[i];
+	if( boardSize <= maxBoardSize[id] ) {
+	    playerIds[numEntrants++] = id;
+	} else if( !options.players.empty() ) {
+	    cerr << playerNames[id] << " only plays on boards up to " << maxBoardSize[id] << endl;
+	    return 1;
+	}
+    }
+    if( numEntrants < 2 ) {
+	cerr << "Fewer than two players can play on a " << boardSize << "x" << boardSize << " board" << endl;
+	return 1;
+    }
+
     // Adjust based on the number of players!
     // Initialize various win statistics 
-    for(int i=0; i<NumPlayers; i++) {
+    for(int i=0; i<numPlayers; i++) {
 	statsShotsTaken[i] = 0;
 	statsGamesCounted[i] = 0;
 	winCount[i] = 0;
-	lives[i] = NumPlayers/2;
-	playerIds[i] = i;
-	for(int j=0; j<NumPlayers; j++) {
+	lives[i] = numEntrants/2;
+	for(int j=0; j<numPlayers; j++) {
 	    wins[i][j] = 0;
     	}
     }
 
-    // Seed (setup) the random number generator.
-    // This only needs to happen once per program run.
-    srand(time(NULL));
-
-    // Now to get the board size.
-    cout << "Welcome to the AI Bot contest." << endl << endl;
-    cout << "What size board would you like? [Anything other than numbers 3-10 exits.] ";
-    cin >> boardSize;
-    // If have invalid board size input (non-number, or 0-2, or > 10).
-    if ( !cin || boardSize < 3 || boardSize > 10 ) {
-	cout << "Exiting" << endl;
-	return 1;
-    }
-
     // Find out how many times to test the AI.
-    cout << "How many times should I test the game AI? ";
-    cin >> totalGames;
+    totalGames = options.rounds;
+    if( totalGames == 0 && options.replayRound < 0 ) {
+	cout << "How many times should I test the game AI? ";
+	cin >> totalGames;
+    }
 
-    cout << "The first game of each AI match is played at the specified speed," << endl
-	 << "all subsequent games are done without visual display." << endl
-	 << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
-    cin >> secondsPerMove;
+    secondsPerMove = options.secondsPerMove;
+    if( secondsPerMove < 0 && !options.headless() ) {
+	cout << "The first game of each AI match is played at the specified speed," << endl
+	     << "all subsequent games are done without visual display." << endl
+	     << "How many seconds per move? (E.g., 1, 0.5, 1.3) : ";
+	cin >> secondsPerMove;
+    }
 
     // And now it's show time!
+    vector<Pairing> pairings;
     int offset=1;
     //int player=0;
-    while( offset<NumPlayers/2 ) {
-	for( int player=0; player+offset<NumPlayers; player+=offset+1 ) {
-	    playMatch(player, player+offset, true);
-	    usleep(3000000);	// Pause 3 seconds to let viewers see stats
+    while( offset<numEntrants/2 ) {
+	for( int player=0; player+offset<numEntrants; player+=offset+1 ) {
+	    Pairing pairing = { playerIds[player], playerIds[player+offset], false };
+	    pairings.push_back(pairing);
 	}
 	++offset;
     }
-    for( int player1Id=0; player1Id<NumPlayers; player1Id++ ) {
-	for( int player2Id=player1Id+1; player2Id<NumPlayers; player2Id++ ) {
+    for( int player1=0; player1<numEntrants; player1++ ) {
+	for( int player2=player1+1; player2<numEntrants; player2++ ) {
+	    Pairing pairing = { playerIds[player1], playerIds[player2], true };
+	    pairings.push_back(pairing);
+	}
+    }
+
+    MatchRunner runner(getPlayer, playerNames, boardSize, seed, makeBoard);
+    if( !options.logFile.empty() ) runner.setLog(&gameLog);
+    runner.setTiming(options.timing);
+    if( options.sandbox ) runner.setSandbox(&sandboxLimits);
+
+    if( !options.ratingsFile.empty() ) {
+	return playRated(runner, seed);
+    }
+
+    // Replaying one game (--game) needs only that game's block.
+    if( options.replayRound >= 0 ) {
+	if( options.replayPairing >= (int)pairings.size() ) {
+	    cerr << "There is no pairing " << options.replayPairing << endl;
+	    return 1;
+	}
+	const Pairing& pairing = pairings[options.replayPairing];
+	MatchJob job = MatchRunner::replayJob(options.replayPairing, pairing.player1Id, pairing.player2Id,
+	                                      options.replayRound, options.blockSize);
+	runner.play(job, options.headless() ? -1 : options.replayRound, false, secondsPerMove, &cout, true);
+	return 0;
+    }
+
+    // With several threads, or with sequential testing, play every match up
+    // front (headless) and report them below in tournament order. Matches
+    // that turn out to involve an eliminated player are simply not reported.
+    vector<MatchStats> results(pairings.size());
+    long roundsPlayed = 0;
+    if( options.sequential() ) {
+	roundsPlayed = playSequential(runner, pairings, results);
+    } else if( options.threads > 1 ) {
+	vector<MatchJob> jobs;
+	for( size_t i=0; i<pairings.size(); i++ ) {
+	    MatchRunner::addJobs(jobs, i, pairings[i].player1Id, pairings[i].player2Id, totalGames, options.blockSize);
+	}
+	vector<MatchStats> jobResults;
+	runner.playAll(jobs, jobResults, options.threads);
+	for( size_t j=0; j<jobs.size(); j++ ) {
+	    results[jobs[j].pairing].add(jobResults[j]);
+	}
+    }
+
+    if( options.format == CsvOutput ) {
+	cout << "player1,player2,wins1,wins2,ties,avgShots1,avgShots2"
+	     << (options.sequential() ? ",played,verdict,low,high" : "") << endl;
+    } else if( options.format == JsonOutput ) {
+	cout << "{\"seed\": " << seed << ", \"board\": " << boardSize << ", \"rounds\": " << totalGames
+	     << "," << endl << " \"matches\": [";
+    }
+
+    for( size_t i=0; i<pairings.size(); i++ ) {
+	int player1Id = pairings[i].player1Id;
+	int player2Id = pairings[i].player2Id;
 
-	    // Don't play anybody who has been eliminated
-	    if(lives[player1Id] == 0 || lives[player2Id] == 0) continue;
+	// Don't play anybody who has been eliminated
+	if( pairings[i].skipEliminated && (lives[player1Id] == 0 || lives[player2Id] == 0) ) continue;
 
-	    playMatch(player1Id, player2Id, true);
-	    usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	if( options.threads > 1 || options.sequential() ) {
+	    reportMatch(player1Id, player2Id, results[i]);
+	    reportTiming(player1Id, player2Id, results[i]);
+	} else {
+	    MatchStats stats = playMatch(runner, i, player1Id, player2Id);
+	    reportMatch(player1Id, player2Id, stats);
+	    reportTiming(player1Id, player2Id, stats);
+	    if( !options.headless() ) {
+		usleep(3000000);	// Pause 3 seconds to let viewers see stats
+	    }
 	}
     }
-    cout << endl << endl;
+    if( text && options.sequential() ) {
+	cout << endl << "Sequential testing played " << roundsPlayed << " of " << totalGames*(long)pairings.size()
+	     << " rounds." << endl;
+    }
+    if( text ) cout << endl << endl;
 
     // Now calculate contest results
-    qsort (playerIds, NumPlayers, sizeof(int), comparePlayers);
+    qsort (playerIds, numEntrants, sizeof(int), comparePlayers);
 
     // Add up the total wins per player
-    for( int i=0; i<NumPlayers; i++ ) {
-	for( int j=0; j<NumPlayers; j++ )
+    for( int i=0; i<numPlayers; i++ ) {
+	for( int j=0; j<numPlayers; j++ )
 	    winCount[i]+= wins[i][j];
     }
 
@@ -131,12 +308,14 @@ int main() {
     //winCount[playerIds[2]] = winCount[playerIds[1]];
     //lives[playerIds[2]] = lives[playerIds[1]];
 
+    if( options.format == CsvOutput ) {
+	cout << endl << "rank,player,lives,wins" << endl;
+    } else if( options.format == JsonOutput ) {
+	cout << "]," << endl << " \"standings\": [";
+    }
+
     int tiesInARow = 0;
-    for( int i=0; i<NumPlayers; ++i ) {
-	// If one of two or more that are tied for first place, switch on BOLD
-	if( lives[playerIds[i]] == lives[playerIds[0]] && winCount[playerIds[i]] == winCount[playerIds[0]]) {
-	    cout << setTextStyle( BOLD );
-	}
+    for( int i=0; i<numEntrants; ++i ) {
 	if(i>0 && lives[playerIds[i]] == lives[playerIds[i-1]] && winCount[playerIds[i]] == winCount[playerIds[i-1]]){
 	    // Have a tie: identify as such
 	    ++tiesInARow;
@@ -144,86 +323,283 @@ int main() {
 	    tiesInARow = 0;
 	}
 
+	if( options.format == CsvOutput ) {
+	    cout << i+1-tiesInARow << "," << playerNames[playerIds[i]] << "," << lives[playerIds[i]]
+		 << "," << winCount[playerIds[i]] << endl;
+	    continue;
+	} else if( options.format == JsonOutput ) {
+	    cout << (i>0 ? "," : "") << endl << "  {\"rank\": " << i+1-tiesInARow
+		 << ", \"player\": " << jsonString(playerNames[playerIds[i]]) << ", \"lives\": " << lives[playerIds[i]]
+		 << ", \"wins\": " << winCount[playerIds[i]] << "}";
+	    continue;
+	}
+
+	// If one of two or more that are tied for first place, switch on BOLD
+	if( lives[playerIds[i]] == lives[playerIds[0]] && winCount[playerIds[i]] == winCount[playerIds[0]]) {
+	    cout << setTextStyle( BOLD );
+	}
+
 	cout << setw(2) << i+1-tiesInARow << ": " << playerNames[playerIds[i]] << " (Lives=" << lives[playerIds[i]] 
 	     << ", Wins=" << winCount[playerIds[i]] << ")";
-	if( (i<NumPlayers-1 && lives[playerIds[1]] == lives[playerIds[1+1]] && winCount[playerIds[i]] == winCount[playerIds[i+1]] )) {
+	if( (i<numEntrants-1 && lives[playerIds[1]] == lives[playerIds[1+1]] && winCount[playerIds[i]] == winCount[playerIds[i+1]] )) {
 	    cout << " -- tied ";
 	}
-	else if( tiesInARow > 0 || (i<NumPlayers-1 && lives[playerIds[i]] == lives[playerIds[i-1]] && winCount[playerIds[i]] == winCount[playerIds[i-1]] )) {
+	else if( tiesInARow > 0 || (i>0 && i<numEntrants-1 && lives[playerIds[i]] == lives[playerIds[i-1]] && winCount[playerIds[i]] == winCount[playerIds[i-1]] )) {
 	    cout << " -- tied ";
 	}
 	cout << resetAll () << endl;
     }
+    if( options.format == JsonOutput ) {
+	cout << endl << " ]}" << endl;
+    }
 
     return 0;
 }
 
-void playMatch( int player1Id, int player2Id, bool showMoves ) {
-    PlayerV2 *player1, *player2;
-    AIContest *game;
-    int matchWins[2] = {0, 0};
-    bool player1Won=false, player2Won=false;
-    int player1Ties=0, player2Ties=0;
-
-    player1 = getPlayer(player1Id, boardSize);
-    player2 = getPlayer(player2Id, boardSize);
-
-    bool silent = true;
-    for( int count=0; count<totalGames; count++ ) {
-	player1Won = false; player2Won = false;
-	player1->newRound();
-	player2->newRound();
-
-	if( count==0 ) {
-	    silent = false;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-				  boardSize, silent );
-	    game->play( secondsPerMove, totalCountedMoves, player1Won, player2Won );
-	} 
-	else {
-	    silent = true;
-	    game = new AIContest( player1, playerNames[player1Id], 
-				  player2, playerNames[player2Id],
-		      boardSize, silent );
-	    game->play( 0, totalCountedMoves, player1Won, player2Won );
+/*
+ * Plays a whole match on this thread, showing the first round unless headless.
+ */
+MatchStats playMatch( MatchRunner& runner, int pairing, int player1Id, int player2Id ) {
+    vector<MatchJob> jobs;
+    MatchRunner::addJobs(jobs, pairing, player1Id, player2Id, totalGames, options.blockSize);
+
+    bool headless = options.headless();
+    MatchStats stats;
+    for( size_t j=0; j<jobs.size(); j++ ) {
+	stats.add(runner.play(jobs[j], headless ? -1 : 0, false, secondsPerMove, headless ? 0 : &cout));
+    }
+    return stats;
+}
+
+/*
+ * Plays every pairing until the sequential test decides it, up to
+ * totalGames rounds, then shares out the rounds the decided matches saved
+ * among the undecided ones, a slice at a time, until they are decided or
+ * the tournament's budget of totalGames rounds per pairing is spent.
+ * Returns the rounds played.
+ */
+long playSequential( MatchRunner& runner, const vector<Pairing>& pairings, vector<MatchStats>& results ) {
+    SequentialTest test(options.confidence, options.margin);
+    vector<vector<MatchJob> > matches(pairings.size());
+    for( size_t i=0; i<pairings.size(); i++ ) {
+	MatchRunner::addJobs(matches[i], i, pairings[i].player1Id, pairings[i].player2Id, totalGames,
+	                     options.blockSize);
+    }
+    results.assign(pairings.size(), MatchStats());
+    runner.playUntilDecided(matches, test, results, options.threads);
+
+    long budget = totalGames * (long)pairings.size();
+    long played = 0;
+    for( size_t i=0; i<results.size(); i++ ) played += results[i].rounds();
+    for(;;) {
+	vector<size_t> undecided;
+	for( size_t i=0; i<results.size(); i++ ) {
+	    if( test.decide(results[i].wins[0], results[i].wins[1]) == Undecided ) undecided.push_back(i);
+	}
+	if( undecided.empty() ) break;
+	// At most another totalGames each, so what a match doesn't need goes
+	// round again.
+	long share = (budget - played) / (long)undecided.size();
+	if( share > totalGames ) share = totalGames;
+	if( share <= 0 ) break;
+
+	vector<vector<MatchJob> > extra(undecided.size());
+	vector<MatchStats> extraResults(undecided.size());
+	for( size_t k=0; k<undecided.size(); k++ ) {
+	    size_t i = undecided[k];
+	    MatchRunner::addJobs(extra[k], i, pairings[i].player1Id, pairings[i].player2Id, share,
+	                         options.blockSize, results[i].rounds());
+	    extraResults[k] = results[i];
 	}
-	if((player1Won && player2Won) || !(player1Won || player2Won)) {
-	    player1Ties++;
-	    player2Ties++;
-	    statsShotsTaken[player1Id] += totalCountedMoves;
-	    statsGamesCounted[player1Id]++;
-	    statsShotsTaken[player2Id] += totalCountedMoves;
-	    statsGamesCounted[player2Id]++;
-	} else if( player1Won ) {
-	    matchWins[0]++;
-	    wins[player1Id][player2Id]++;
-	    statsShotsTaken[player1Id] += totalCountedMoves;
-	    statsGamesCounted[player1Id]++;
-	} else if( player2Won ) {
-	    matchWins[1]++;
-	    wins[player2Id][player1Id]++;
-	    statsShotsTaken[player2Id] += totalCountedMoves;
-	    statsGamesCounted[player2Id]++;
+	runner.playUntilDecided(extra, test, extraResults, options.threads);
+	for( size_t k=0; k<undecided.size(); k++ ) {
+	    played += extraResults[k].rounds() - results[undecided[k]].rounds();
+	    results[undecided[k]] = extraResults[k];
 	}
-	delete game;
     }
-    delete player1;
-    delete player2;
+    return played;
+}
+
+/*
+ * Plays rated matches (--ratings): each time, the entrant whose rating is
+ * least certain plays the opponent a game against tells the most about it,
+ * until every entrant's deviation is at most options.targetDeviation (or
+ * after 20 matches per entrant, in case surprises keep a deviation up). An
+ * entrant whose best match no longer brings its deviation down, as when it
+ * loses every game to everybody, is left where it is.
+ * Saves the ratings and prints the leaderboard of everybody in the file.
+ */
+int playRated( MatchRunner& runner, unsigned int seed ) {
+    RatingTable table(boardSize);
+    if( !table.load(options.ratingsFile) ) {
+	cerr << table.error() << endl;
+	return 1;
+    }
+    int rated[MaxPlayers];	// Each entrant's place in the table
+    bool settled[MaxPlayers];	// Its matches stopped teaching us anything
+    for( int i=0; i<numEntrants; i++ ) {
+	rated[i] = table.find(playerNames[playerIds[i]]);
+	settled[i] = false;
+    }
+
+    if( options.format == CsvOutput ) {
+	cout << "match,player1,player2,wins1,wins2,ties" << endl;
+    } else if( options.format == JsonOutput ) {
+	cout << "{\"seed\": " << seed << ", \"board\": " << boardSize << ", \"rounds\": " << totalGames
+	     << "," << endl << " \"matches\": [";
+    }
+    for( int match=0; match<20*numEntrants; match++ ) {
+	int player1 = -1;
+	for( int i=0; i<numEntrants; i++ ) {
+	    if( !settled[i] && (player1 < 0 || table[rated[i]].deviation > table[rated[player1]].deviation) ) {
+		player1 = i;
+	    }
+	}
+	if( player1 < 0 || table[rated[player1]].deviation <= options.targetDeviation ) break;
+	int player2 = -1;
+	for( int i=0; i<numEntrants; i++ ) {
+	    if( i != player1 && (player2 < 0 ||
+		table.information(rated[player1], rated[i]) > table.information(rated[player1], rated[player2])) ) {
+		player2 = i;
+	    }
+	}
+
+	vector<MatchJob> jobs;
+	MatchRunner::addJobs(jobs, match, playerIds[player1], playerIds[player2], totalGames, options.blockSize);
+	MatchStats stats;
+	if( options.sequential() ) {
+	    vector<vector<MatchJob> > matches(1, jobs);
+	    vector<MatchStats> results;
+	    runner.playUntilDecided(matches, SequentialTest(options.confidence, options.margin), results, 1);
+	    stats = results[0];
+	} else {
+	    vector<MatchStats> jobResults;
+	    runner.playAll(jobs, jobResults, options.threads);
+	    for( size_t j=0; j<jobs.size(); j++ ) stats.add(jobResults[j]);
+	}
+	double deviation = table[rated[player1]].deviation;
+	table.addMatch(rated[player1], rated[player2], stats.wins[0], stats.wins[1], stats.ties);
+	settled[player1] = table[rated[player1]].deviation > 0.99*deviation;
+	reportTiming(playerIds[player1], playerIds[player2], stats);
+
+	const string& name1 = playerNames[playerIds[player1]];
+	const string& name2 = playerNames[playerIds[player2]];
+	if( options.format == CsvOutput ) {
+	    cout << match << "," << name1 << "," << name2 << "," << stats.wins[0] << "," << stats.wins[1] << ","
+		 << stats.ties << endl;
+	} else if( options.format == JsonOutput ) {
+	    cout << (match>0 ? "," : "") << endl << "  {\"match\": " << match << ", \"player1\": " << jsonString(name1)
+		 << ", \"player2\": " << jsonString(name2) << ", \"wins1\": " << stats.wins[0] << ", \"wins2\": "
+		 << stats.wins[1] << ", \"ties\": " << stats.ties << "}";
+	} else {
+	    cout << "Match " << match << ": " << name1 << " " << stats.wins[0] << ", " << name2 << " "
+		 << stats.wins[1] << ", ties " << stats.ties << endl;
+	}
+    }
+    if( !table.save(options.ratingsFile) ) {
+	cerr << table.error() << endl;
+	return 1;
+    }
+
+    // Leaderboard, best first.
+    vector<int> order;
+    for( int i=0; i<table.size(); i++ ) {
+	size_t place = 0;
+	while( place < order.size() && table[order[place]].rating >= table[i].rating ) place++;
+	order.insert(order.begin()+place, i);
+    }
+    if( options.format == CsvOutput ) {
+	cout << endl << "rank,player,rating,low,high,deviation,games" << endl;
+    } else if( options.format == JsonOutput ) {
+	cout << "]," << endl << " \"ratings\": [";
+    } else {
+	cout << endl << "Rank  Player              Rating    95% interval   Games" << endl;
+    }
+    for( size_t rank=0; rank<order.size(); rank++ ) {
+	const Rating& rating = table[order[rank]];
+	double low, high;
+	table.interval(order[rank], low, high);
+	if( options.format == CsvOutput ) {
+	    cout << rank+1 << "," << rating.name << "," << rating.rating << "," << low << "," << high << ","
+		 << rating.deviation << "," << rating.games << endl;
+	} else if( options.format == JsonOutput ) {
+	    cout << (rank>0 ? "," : "") << endl << "  {\"rank\": " << rank+1 << ", \"player\": " << jsonString(rating.name)
+		 << ", \"rating\": " << rating.rating << ", \"low\": " << low << ", \"high\": " << high
+		 << ", \"deviation\": " << rating.deviation << ", \"games\": " << rating.games << "}";
+	} else {
+	    cout << setw(4) << rank+1 << "  " << left << setw(18) << rating.name.substr(0, 18) << right << fixed
+		 << setprecision(0) << setw(8) << rating.rating << setw(8) << low << " - " << setw(5) << high
+		 << setw(8) << rating.games << endl;
+	}
+    }
+    if( options.format == JsonOutput ) {
+	cout << endl << " ]}" << endl;
+    }
+    return 0;
+}
+
+/*
+ * Adds a match's results to the tournament statistics and prints the summary.
+ */
+void reportMatch( int player1Id, int player2Id, const MatchStats& stats ) {
+    static int matchesReported = 0;
+    const int* matchWins = stats.wins;
+    int player1Ties = stats.ties, player2Ties = stats.ties;
+
+    wins[player1Id][player2Id] += stats.wins[0];
+    wins[player2Id][player1Id] += stats.wins[1];
+    statsShotsTaken[player1Id] += stats.shotsTaken[0];
+    statsGamesCounted[player1Id] += stats.gamesCounted[0];
+    statsShotsTaken[player2Id] += stats.shotsTaken[1];
+    statsGamesCounted[player2Id] += stats.gamesCounted[1];
+    float avgShots1 = statsGamesCounted[player1Id]==0 ? 0.0 :
+	(float)statsShotsTaken[player1Id]/(float)statsGamesCounted[player1Id];
+    float avgShots2 = statsGamesCounted[player2Id]==0 ? 0.0 :
+	(float)statsShotsTaken[player2Id]/(float)statsGamesCounted[player2Id];
+    SequentialTest test(options.sequential() ? options.confidence : 0.95, options.margin);
+    double low, high;
+    test.interval(matchWins[0], matchWins[1], low, high);
+
+    if( options.format != TextOutput ) {
+	// Same bookkeeping as below, without the commentary.
+	if(wins[player1Id][player2Id] >= wins[player2Id][player1Id]) lives[player2Id]--;
+	if(wins[player1Id][player2Id] <= wins[player2Id][player1Id]) lives[player1Id]--;
+
+	if( options.format == CsvOutput ) {
+	    cout << playerNames[player1Id] << "," << playerNames[player2Id] << "," << matchWins[0] << ","
+		 << matchWins[1] << "," << player1Ties << "," << avgShots1 << "," << avgShots2;
+	    if( options.sequential() ) {
+		cout << "," << stats.rounds() << "," << SequentialTest::verdictName(test.decide(matchWins[0], matchWins[1]))
+		     << "," << low << "," << high;
+	    }
+	    cout << endl;
+	} else {
+	    cout << (matchesReported>0 ? "," : "") << endl
+		 << "  {\"player1\": " << jsonString(playerNames[player1Id]) << ", \"player2\": " << jsonString(playerNames[player2Id])
+		 << ", \"wins1\": " << matchWins[0] << ", \"wins2\": " << matchWins[1] << ", \"ties\": " << player1Ties
+		 << ", \"avgShots1\": " << avgShots1 << ", \"avgShots2\": " << avgShots2;
+	    if( options.sequential() ) {
+		cout << ", \"played\": " << stats.rounds() << ", \"verdict\": \""
+		     << SequentialTest::verdictName(test.decide(matchWins[0], matchWins[1])) << "\", \"low\": " << low
+		     << ", \"high\": " << high;
+	    }
+	    cout << "}";
+	}
+	matchesReported++;
+	return;
+    }
 
     cout << endl << "********************" << endl;
     cout << playerNames[player1Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[0] << resetAll()
-	 << " losses=" << totalGames-matchWins[0]-player1Ties 
-	 << " ties=" << player1Ties << " (cumulative avg. shots/game = "
-	 << (statsGamesCounted[player1Id]==0 ? 0.0 : 
-	    (float)statsShotsTaken[player1Id]/(float)statsGamesCounted[player1Id])
-	 << ")" << endl;
+	 << " losses=" << stats.rounds()-matchWins[0]-player1Ties 
+	 << " ties=" << player1Ties << " (cumulative avg. shots/game = " << avgShots1 << ")" << endl;
     cout << playerNames[player2Id] << ": " << setTextStyle( NEGATIVE_IMAGE ) << "wins=" << matchWins[1] << resetAll()
-	 << " losses=" << totalGames-matchWins[1]-player2Ties 
-	 << " ties=" << player2Ties << " (cumulative avg. shots/game = "
-	 << (statsGamesCounted[player2Id]==0 ? 0.0 : 
-	    (float)statsShotsTaken[player2Id]/(float)statsGamesCounted[player2Id])
-	 << ")" << endl;
+	 << " losses=" << stats.rounds()-matchWins[1]-player2Ties 
+	 << " ties=" << player2Ties << " (cumulative avg. shots/game = " << avgShots2 << ")" << endl;
+    if( options.sequential() ) {
+	string names[2] = { playerNames[player1Id], playerNames[player2Id] };
+	printVerdict(cout, names, test, matchWins[0], matchWins[1], stats.rounds(), totalGames);
+    }
     cout << "********************" << endl;
 
     cout << setTextStyle( NEGATIVE_IMAGE );
@@ -253,6 +629,7 @@ void playMatch( int player1Id, int player2Id, bool showMoves ) {
 	cout << playerNames[player1Id] << " Lives left: " << lives[player1Id] << endl;
     }
     cout << resetAll() << "********************" << endl;
+    matchesReported++;
 }
 
 int comparePlayers (const void * a, const void * b) {
@@ -268,12 +645,59 @@ int comparePlayers (const void * a, const void * b) {
 }
 
 PlayerV2* getPlayer( int playerId, int boardSize ) {
+    if( playerId >= NumBuiltInPlayers ) {
+	return plugins[playerId - NumBuiltInPlayers].create( boardSize );
+    }
     switch( playerId ) {
 	// Professor provided
 	default:
 	case 0: return new DumbPlayerV2( boardSize );
 	case 1: return new GamblerPlayerV2( boardSize );
 	case 2: return new CleanPlayerV2( boardSize );
+	case 3: return new DensityPlayer( boardSize );
+	case 4: return new TablebasePlayer( boardSize );
+	case 5: return new MonteCarloPlayer( boardSize, options.moveBudgetMicros, options.moveThreads,
+					     options.moveSamples );
+    }
+}
+
+/*
+ * Adds the players in the plugin directory after the built-in ones.
+ * Returns false if --plugins named a directory that can't be read.
+ */
+bool loadPlugins( bool text ) {
+    string directory = options.pluginDir.empty() ? "plugins" : options.pluginDir;
+    if( !plugins.load(directory, playerNames, NumBuiltInPlayers) && !options.pluginDir.empty() ) {
+	cerr << "Can't read plugin directory " << directory << endl;
+	return false;
+    }
+    for( size_t i=0; i<plugins.problems().size(); i++ ) {
+	cerr << "Plugin skipped: " << plugins.problems()[i] << endl;
     }
+    for( int i=0; i<plugins.size(); i++ ) {
+	if( numPlayers == MaxPlayers ) {
+	    cerr << "Plugin skipped: " << plugins[i].file << ": more than " << MaxPlayers << " players" << endl;
+	    continue;
+	}
+	playerNames[numPlayers] = plugins[i].name;
+	maxBoardSize[numPlayers] = min(plugins[i].maxBoardSize, MAX_LARGE_BOARD_SIZE);
+	numPlayers++;
+	if( text ) {
+	    cout << "Plugin " << plugins[i].name << " " << plugins[i].version << " (" << plugins[i].file << ")" << endl;
+	}
+    }
+    return true;
 }
 
+/*
+ * Prints how long the players' calls took in the match (--timing) and
+ * dumps the histograms (--timing-csv).
+ */
+void reportTiming( int player1Id, int player2Id, const MatchStats& stats ) {
+    if( stats.timing.empty() ) return;
+    string names[2] = { playerNames[player1Id], playerNames[player2Id] };
+    ostream& out = options.format == TextOutput ? cout : cerr;
+    printTimingTable(out, names, &stats.timing[0]);
+    out << endl;
+    if( timingCsv.is_open() ) writeTimingCsv(timingCsv, names, &stats.timing[0]);
+}
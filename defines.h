@@ -33,6 +33,18 @@ using namespace std;
     const int MAX_SHIP_SIZE = 5;
     const int MIN_SHIP_SIZE = 3;
 
+    // Largest board for players that size their state at run time (see
+    // Grid.h). The classic players stop at MAX_BOARD_SIZE.
+    const int MAX_LARGE_BOARD_SIZE = 128;
+
     enum Direction { None=0, Horizontal=1, Vertical=2 };
 
+    // Where a ship lies: top/left cell, length and direction (length 0 for none).
+    struct ShipLocation {
+	int row;
+	int col;
+	int length;
+	Direction dir;
+    };
+
 #endif
@@ -0,0 +1,245 @@
+/**
+ * replay.cpp: shows or checks the games in a game log (contest/testAI --log).
+ * Date:       October 2026
+ *
+ *   ./replay games.log                 show every game, as contest does
+ *   ./replay --game 2:17 games.log     show one game
+ *   ./replay --verify games.log        replay every shot on fresh boards and
+ *                                      check the logged results and outcome
+ *
+ * Showing a game plays it through AIContest with two players that repeat
+ * the logged placements and shots, so the screen is the one contest draws.
+ * Neither mode needs the original players.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+#include <getopt.h>
+
+#include "GameLog.h"
+#include "AIContest.h"
+#include "GameBoard.h"
+#include "PackedPlayerV2.h"
+#include "defines.h"
+
+using namespace std;
+
+namespace {
+    /*
+     * Plays one side of a logged game: places the logged ships, takes the
+     * logged shots and counts results that differ from the log.
+     */
+    class ScriptedPlayer: public PackedPlayerV2 {
+      public:
+	ScriptedPlayer( const GameRecord& record, int side ) : PackedPlayerV2(record.boardSize), record(record) {
+	    this->side = side;
+	    newRound();
+	}
+
+	void newRound() override {
+	    nextShip = 0;
+	    nextShot = side;
+	    mismatches = 0;
+	}
+
+	PackedMessage placePackedShip( int length ) override {
+	    if( nextShip >= record.shipsPlaced[side] ) return PackedMessage(PLACE_SHIP);
+	    const ShipPlacement& ship = record.placements[side][nextShip++];
+	    return PackedMessage(PLACE_SHIP, ship.row, ship.col, ship.dir, length);
+	}
+
+	PackedMessage getPackedMove() override {
+	    if( nextShot >= record.numShots ) return PackedMessage(SHOT);	// Log ran out
+	    PackedMessage shot(SHOT, record.shotRow(nextShot), record.shotCol(nextShot));
+	    nextShot += 2;
+	    return shot;
+	}
+
+	void updatePacked( PackedMessage msg ) override {
+	    switch( msg.getMessageType() ) {
+		case MISS: case HIT: case DUPLICATE_SHOT: case INVALID_SHOT:
+		    check(msg.getMessageType());
+		    break;
+	    }
+	}
+
+	void updateKill( const ShipKill& ) override {
+	    check(KILL);
+	}
+
+	int mismatches;
+
+      private:
+	// The result of the shot just taken (nextShot-2).
+	void check( char result ) {
+	    int shot = nextShot-2;
+	    if( shot >= 0 && shot < record.numShots && record.shotResults[shot] != result ) mismatches++;
+	}
+
+	const GameRecord& record;
+	int side;
+	int nextShip;
+	int nextShot;
+    };
+
+    bool wanted( const GameRecord& record, int pairing, int round ) {
+	return round < 0 || (record.haveGameId && record.game.pairing == pairing && record.game.round == round);
+    }
+
+    string gameName( const GameRecord& record, int index ) {
+	if( record.haveGameId ) return "game " + to_string(record.game.pairing) + ":" + to_string(record.game.round);
+	return "game #" + to_string(index);
+    }
+
+    /*
+     * Plays the logged game on the boards exactly as AIContest::play()
+     * does. Returns the first difference from the log, or "" if none.
+     */
+    string replayOn( const GameRecord& record, GameBoard* boards[2] ) {
+	bool won[2] = { false, false };
+
+	for( int side=0; side<2; side++ ) {
+	    int placed = 0;
+	    bool ok = true;
+	    while( ok && placed < record.numShips && placed < record.shipsPlaced[side] ) {
+		const ShipPlacement& ship = record.placements[side][placed++];
+		ok = boards[side]->placeShip(ship.row, ship.col, record.shipLengths[placed-1], ship.dir);
+	    }
+	    if( placed != record.shipsPlaced[side] || (ok && placed < record.numShips) ) {
+		return "player " + to_string(side+1) + "'s placements don't match the fleet";
+	    }
+	    won[1-side] = !ok;	// Forfeit
+	}
+
+	int maxShots = record.boardSize*record.boardSize*2;
+	int moves = 0, shot = 0;
+	while( !(won[0] || won[1]) && moves < maxShots ) {
+	    for( int side=0; side<2; side++, shot++ ) {
+		if( shot >= record.numShots ) return "the log ends at shot " + to_string(shot);
+		GameBoard* target = boards[1-side];
+		char result = target->processShot(record.shotRow(shot), record.shotCol(shot));
+		if( result != record.shotResults[shot] ) {
+		    return "shot " + to_string(shot) + " was '" + string(1, record.shotResults[shot])
+			   + "', replays as '" + string(1, result) + "'";
+		}
+		won[side] = result == KILL && target->hasWon();
+	    }
+	    moves++;
+	}
+	if( shot != record.numShots ) return "shots logged after the game ended";
+	if( moves != record.totalMoves ) return "game took " + to_string(moves) + " moves, logged "
+						+ to_string(record.totalMoves);
+	if( won[0] != record.playerWon[0] || won[1] != record.playerWon[1] ) return "the logged winner is wrong";
+	return "";
+    }
+
+    // Plays the logged game on fresh boards of the size it was played on.
+    string verify( const GameRecord& record ) {
+	BoardFactory makeBoard = boardFactory(record.boardSize);
+	GameBoard* boards[2] = { makeBoard(record.boardSize), makeBoard(record.boardSize) };
+	string problem = replayOn(record, boards);
+	delete boards[0];
+	delete boards[1];
+	return problem;
+    }
+
+    void usage( const char* program ) {
+	cerr << "Usage: " << program << " [options] LOGFILE" << endl
+	     << "  -g, --game [P:]R      only game R of pairing P" << endl
+	     << "  -d, --delay SECONDS   seconds per move when showing games (default 0.2)" << endl
+	     << "  -v, --verify          check the games without showing them" << endl;
+    }
+}
+
+int main( int argc, char* argv[] ) {
+    static const struct option longOptions[] = {
+	{ "game",   required_argument, 0, 'g' },
+	{ "delay",  required_argument, 0, 'd' },
+	{ "verify", no_argument,       0, 'v' },
+	{ "help",   no_argument,       0, 'h' },
+	{ 0, 0, 0, 0 }
+    };
+    int pairing = 0, round = -1;
+    float secondsPerMove = 0.2;
+    bool verifyOnly = false;
+
+    int opt;
+    while( (opt = getopt_long(argc, argv, "g:d:vh", longOptions, 0)) != -1 ) {
+	switch( opt ) {
+	    case 'g': {
+		string value = optarg;
+		size_t colon = value.find(':');
+		if( colon != string::npos ) pairing = atoi(value.substr(0, colon).c_str());
+		round = atoi(value.substr(colon == string::npos ? 0 : colon+1).c_str());
+		break;
+	    }
+	    case 'd': secondsPerMove = atof(optarg); break;
+	    case 'v': verifyOnly = true; break;
+	    default: usage(argv[0]); return 1;
+	}
+    }
+    if( optind != argc-1 ) {
+	usage(argv[0]);
+	return 1;
+    }
+
+    GameLogReader log;
+    if( !log.open(argv[optind]) ) {
+	cerr << log.error() << endl;
+	return 1;
+    }
+
+    // Big enough to reuse for every game.
+    GameRecord* record = new GameRecord;
+    int games = 0, problems = 0;
+    long shots = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for( int index=0; log.next(*record); index++ ) {
+	if( !wanted(*record, pairing, round) ) continue;
+	games++;
+	shots += record->numShots;
+
+	if( verifyOnly ) {
+	    string problem = verify(*record);
+	    if( !problem.empty() ) {
+		cout << gameName(*record, index) << ": " << problem << endl;
+		problems++;
+	    }
+	    continue;
+	}
+
+	ScriptedPlayer player1(*record, 0), player2(*record, 1);
+	AIContest* game = record->haveGameId
+	    ? new AIContest(&player1, record->playerNames[0], &player2, record->playerNames[1],
+			    record->boardSize, false, record->game, boardFactory(record->boardSize))
+	    : new AIContest(&player1, record->playerNames[0], &player2, record->playerNames[1],
+			    record->boardSize, false);
+	game->setShipLengths(&record->shipLengths[0]);
+	int totalMoves = 0;
+	bool player1Won = false, player2Won = false;
+	game->play(secondsPerMove, totalMoves, player1Won, player2Won);
+	delete game;
+	if( player1.mismatches + player2.mismatches > 0 || totalMoves != record->totalMoves
+	    || player1Won != record->playerWon[0] || player2Won != record->playerWon[1] ) {
+	    cout << gameName(*record, index) << ": replay differs from the log" << endl;
+	    problems++;
+	}
+    }
+    delete record;
+    if( !log.error().empty() ) {
+	cerr << log.error() << endl;
+	problems++;
+    }
+
+    if( verifyOnly ) {
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	cout << games << " games, " << shots << " shots checked in " << seconds << " s ("
+	     << (seconds > 0 ? shots/seconds/1e6 : 0) << " million shots/s), "
+	     << problems << " problems" << endl;
+    } else if( games == 0 ) {
+	cout << "No such game in the log" << endl;
+    }
+    return problems > 0 ? 1 : 0;
+}